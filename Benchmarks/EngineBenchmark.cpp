@@ -0,0 +1,302 @@
+#include "LooperEngine.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+//==============================================================================
+/*
+    Times LooperEngine::processBlock() and prints each configuration's cost per block,
+    and that cost as a share of the block's real-time budget. Built with
+    -DBOOMERANG_BUILD_BENCHMARKS=ON; run it from a Release build.
+*/
+namespace
+{
+    constexpr double loopSeconds = 2.0;
+    constexpr double timedSeconds = 20.0;
+
+    //==============================================================================
+    struct Config
+    {
+        double sampleRate = 48000.0;
+        int blockSize = 512;
+        int numChannels = 2;
+    };
+
+    // Deterministic white noise, so every run loops the same audio
+    class Noise
+    {
+    public:
+        void fill(juce::AudioBuffer<float>& buffer)
+        {
+            for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            {
+                auto* samples = buffer.getWritePointer(channel);
+
+                for (int i = 0; i < buffer.getNumSamples(); ++i)
+                {
+                    state = state * 1664525u + 1013904223u;
+                    samples[i] = 0.25f * (static_cast<float>(state >> 8) / 8388608.0f - 1.0f);
+                }
+            }
+        }
+
+    private:
+        juce::uint32 state = 1;
+    };
+
+    //==============================================================================
+    class Bench
+    {
+    public:
+        explicit Bench(const Config& configToUse)
+            : config(configToUse), buffer(config.numChannels, config.blockSize)
+        {
+            engine.prepare(config.sampleRate, config.blockSize, config.numChannels);
+        }
+
+        // Records loopSeconds of noise into the active slot and leaves it playing
+        void recordLoop()
+        {
+            engine.onRecordButtonPressed();
+            process(loopSeconds);
+            engine.onRecordButtonPressed();
+        }
+
+        void process(double seconds)
+        {
+            const int numBlocks = juce::jmax(1, static_cast<int>(seconds * config.sampleRate / config.blockSize));
+
+            for (int block = 0; block < numBlocks; ++block)
+            {
+                noise.fill(buffer);
+                advanceHost();
+                engine.processBlock(buffer);
+            }
+        }
+
+        // A playing host at bpm, which the engine follows from the next block on
+        void runHost(double bpm)
+        {
+            transport.hasTempo = true;
+            transport.hasPpq = true;
+            transport.isPlaying = true;
+            transport.bpm = bpm;
+        }
+
+        // Microseconds per block. The median keeps a busy machine's interruptions out of the
+        // figure; the mean and the worst show work that only some blocks do.
+        struct Result
+        {
+            double median = 0.0;
+            double mean = 0.0;
+            double worst = 0.0;
+            double budget = 0.0;    // The block's duration
+        };
+
+        Result time()
+        {
+            process(0.5);   // Warm up: caches, and anything waiting for a seam
+
+            std::vector<double> times(static_cast<size_t>(timedSeconds * config.sampleRate / config.blockSize));
+
+            for (auto& time : times)
+            {
+                noise.fill(buffer);
+                advanceHost();
+
+                const auto start = std::chrono::steady_clock::now();
+                engine.processBlock(buffer);
+                time = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+            }
+
+            Result result;
+            result.budget = 1.0e6 * config.blockSize / config.sampleRate;
+
+            for (const auto time : times)
+            {
+                result.mean += time / static_cast<double>(times.size());
+                result.worst = juce::jmax(result.worst, time);
+            }
+
+            std::nth_element(times.begin(), times.begin() + static_cast<std::ptrdiff_t>(times.size() / 2), times.end());
+            result.median = times[times.size() / 2];
+            return result;
+        }
+
+        LooperEngine engine;
+
+    private:
+        void advanceHost()
+        {
+            if (!transport.isPlaying)
+                return;
+
+            engine.setHostTransport(transport);
+            transport.ppqPosition += config.blockSize * transport.bpm / (60.0 * config.sampleRate);
+        }
+
+        Config config;
+        LooperEngine::HostTransport transport;
+        juce::AudioBuffer<float> buffer;
+        Noise noise;
+    };
+
+    void printRow(const char* label, const Bench::Result& result)
+    {
+        std::printf("  %-28s %9.2f us/block  %6.3f%% of real time\n", label, result.median, 100.0 * result.median / result.budget);
+    }
+
+    //==============================================================================
+    // Multi-track: every recorded slot plays at once, each with its own gain
+    void benchmarkTracks()
+    {
+        std::printf("Multi-track playback, 48 kHz, stereo, 512-sample blocks\n");
+
+        for (int numTracks = 1; numTracks <= LooperEngine::maxLoopSlots; ++numTracks)
+        {
+            Bench bench({});
+            bench.engine.setPlaybackMode(LooperEngine::PlaybackMode::MultiTrack);
+
+            // Record closes a take and plays it; pressed again, it records the next slot
+            for (int track = 0; track < numTracks; ++track)
+            {
+                if (track > 0)
+                    bench.engine.onRecordButtonPressed();
+
+                bench.engine.onRecordButtonPressed();
+                bench.process(loopSeconds);
+            }
+
+            bench.engine.onRecordButtonPressed();
+
+            for (int track = 0; track < numTracks; ++track)
+                bench.engine.setSlotGain(track, 0.8f);
+
+            char label[64];
+            std::snprintf(label, sizeof(label), "%d track%s", numTracks, numTracks > 1 ? "s" : "");
+            printRow(label, bench.time());
+        }
+    }
+
+    //==============================================================================
+    // Discrete channels: playback, and overdubbing with Stack held
+    void benchmarkChannels()
+    {
+        std::printf("Channels, one loop, 48 kHz, 512-sample blocks\n");
+
+        for (int numChannels : { 1, 2, 4, 6, 8 })
+        {
+            Config config;
+            config.numChannels = numChannels;
+
+            char label[64];
+            Bench bench(config);
+            bench.recordLoop();
+
+            std::snprintf(label, sizeof(label), "%d ch, playback", numChannels);
+            printRow(label, bench.time());
+
+            bench.engine.onStackButtonPressed();
+            std::snprintf(label, sizeof(label), "%d ch, overdub", numChannels);
+            printRow(label, bench.time());
+            bench.engine.onStackButtonReleased();
+        }
+    }
+
+    //==============================================================================
+    // Tempo following: a loop recorded in sync at 120 BPM (two bars), played at other host tempos
+    void benchmarkTempo()
+    {
+        std::printf("Tempo following, two stereo bars recorded at 120 BPM, 512-sample blocks\n");
+
+        for (double sampleRate : { 48000.0, 96000.0 })
+        {
+            for (double bpm : { 120.0, 90.0, 150.0, 200.0 })
+            {
+                Config config;
+                config.sampleRate = sampleRate;
+
+                Bench bench(config);
+                bench.engine.setSyncMode(LooperEngine::SyncMode::Bars);
+                bench.runHost(120.0);
+
+                // Both presses wait for a bar line
+                bench.engine.onRecordButtonPressed();
+                bench.process(2.5);
+                bench.engine.onRecordButtonPressed();
+                bench.process(2.5);
+                bench.runHost(bpm);
+
+                char label[64];
+                std::snprintf(label, sizeof(label), "%.0f kHz, %.0f BPM", sampleRate / 1000.0, bpm);
+                printRow(label, bench.time());
+            }
+        }
+    }
+
+    //==============================================================================
+    // Varispeed: one loop played at each ratio, in frames resampled per second of CPU
+    void benchmarkVarispeed()
+    {
+        std::printf("Varispeed, one stereo loop, 48 kHz, 512-sample blocks\n");
+
+        for (float speed : { 0.25f, 0.5f, 0.75f, 1.0f, 1.5f, 2.0f, 3.0f, 4.0f })
+        {
+            Bench bench({});
+            bench.recordLoop();
+            bench.engine.setVarispeed(speed);
+
+            const auto result = bench.time();
+            char label[64];
+            std::snprintf(label, sizeof(label), "%.2fx", speed);
+            std::printf("  %-28s %9.2f us/block  %6.1f M frames/s\n", label, result.median, Config().blockSize / result.median);
+        }
+    }
+
+    //==============================================================================
+    // Time-stretch: half speed through the phase vocoder, which analyses and resynthesises
+    // one FFT frame per hop, so small blocks have a frame in some blocks and none in others
+    void benchmarkTimeStretch()
+    {
+        std::printf("Time-stretch at half speed, one stereo loop (one %d-point FFT frame per channel every %d samples)\n",
+                    TimeStretcher::frameSize, TimeStretcher::hopSize);
+
+        for (double sampleRate : { 48000.0, 96000.0 })
+        {
+            for (int blockSize : { 64, 128, 512, 2048 })
+            {
+                Config config;
+                config.sampleRate = sampleRate;
+                config.blockSize = blockSize;
+
+                Bench bench(config);
+                bench.recordLoop();
+                bench.engine.setTimeStretch(true);
+
+                // Stack while stopped toggles half speed
+                bench.engine.onPlayButtonPressed();
+                bench.engine.onStackButtonPressed();
+                bench.engine.onStackButtonReleased();
+                bench.engine.onPlayButtonPressed();
+
+                const auto result = bench.time();
+                char label[64];
+                std::snprintf(label, sizeof(label), "%.0f kHz, %d-sample blocks", sampleRate / 1000.0, blockSize);
+                std::printf("  %-28s %9.2f us/block mean  %9.2f worst  %6.3f%% of real time\n",
+                            label, result.mean, result.worst, 100.0 * result.mean / result.budget);
+            }
+        }
+    }
+}
+
+//==============================================================================
+int main()
+{
+    benchmarkTracks();
+    benchmarkChannels();
+    benchmarkTempo();
+    benchmarkVarispeed();
+    benchmarkTimeStretch();
+    return 0;
+}
@@ -0,0 +1,87 @@
+#include "DecayFilter.h"
+#include <cmath>
+
+//==============================================================================
+template <typename SampleType>
+void DecayFilter<SampleType>::prepare(double newSampleRate)
+{
+    sampleRate = newSampleRate;
+    appliedToneHz = -1.0f;  // Recompute for the new rate
+    reset();
+}
+
+template <typename SampleType>
+void DecayFilter<SampleType>::reset() noexcept
+{
+    state1.fill(SampleType(0));
+    state2.fill(SampleType(0));
+}
+
+template <typename SampleType>
+void DecayFilter<SampleType>::setDecay(float gainDecibels, float toneHz) noexcept
+{
+    if (gainDecibels == appliedDecibels && toneHz == appliedToneHz)
+        return;
+
+    appliedDecibels = gainDecibels;
+    appliedToneHz = toneHz;
+    gain = static_cast<SampleType>(juce::Decibels::decibelsToGain(gainDecibels, -100.0f));
+
+    const double cutoff = juce::jmin(static_cast<double>(toneHz), sampleRate * 0.45);
+    const bool wasFiltering = filtering;
+    filtering = (toneHz < maxToneHz && cutoff > 0.0);
+
+    if (filtering && !wasFiltering)
+        reset();  // Don't start from a history the bypass never updated
+
+    if (!filtering)
+        return;
+
+    // Butterworth (Q = 1/sqrt(2)) low-pass
+    const double theta = juce::MathConstants<double>::twoPi * cutoff / sampleRate;
+    const double alpha = std::sin(theta) * juce::MathConstants<double>::sqrt2 * 0.5;
+    const double cosTheta = std::cos(theta);
+    const double a0Reciprocal = 1.0 / (1.0 + alpha);
+
+    b0 = static_cast<SampleType>((1.0 - cosTheta) * 0.5 * a0Reciprocal);
+    b1 = static_cast<SampleType>((1.0 - cosTheta) * a0Reciprocal);
+    b2 = b0;
+    a1 = static_cast<SampleType>(-2.0 * cosTheta * a0Reciprocal);
+    a2 = static_cast<SampleType>((1.0 - alpha) * a0Reciprocal);
+}
+
+template <typename SampleType>
+void DecayFilter<SampleType>::process(SampleType* const* channels, int numChannels, int start, int numSamples, int step,
+                                      float startMix, float mixStep) noexcept
+{
+    jassert(numChannels <= lanes);
+
+    // Unused lanes stay at zero in and out, so the lane loop can always run full width
+    alignas(32) SampleType x[lanes] = {};
+    alignas(32) SampleType y[lanes];
+    SampleType* s1 = state1.data();
+    SampleType* s2 = state2.data();
+
+    for (int i = 0, index = start; i < numSamples; ++i, index += step)
+    {
+        for (int lane = 0; lane < numChannels; ++lane)
+            x[lane] = channels[lane][index];
+
+        for (int lane = 0; lane < lanes; ++lane)
+        {
+            y[lane] = b0 * x[lane] + s1[lane];
+            s1[lane] = b1 * x[lane] - a1 * y[lane] + s2[lane];
+            s2[lane] = b2 * x[lane] - a2 * y[lane];
+        }
+
+        // mix 0 leaves the sample dry (a punch fading in or out), 1 is fully decayed
+        const auto mix = static_cast<SampleType>(startMix + mixStep * static_cast<float>(i));
+
+        for (int lane = 0; lane < numChannels; ++lane)
+            channels[lane][index] = x[lane] + mix * (gain * y[lane] - x[lane]);
+    }
+}
+
+//==============================================================================
+template class DecayFilter<float>;
+template class DecayFilter<double>;
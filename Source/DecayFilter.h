@@ -0,0 +1,58 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <array>
+
+//==============================================================================
+/**
+    Tape-style decay for the loop under an overdub
+
+    Each pass the loop being stacked over is turned down by the decay gain and, with the
+    tone below maxToneHz, darkened by a 12 dB/oct low-pass, so older layers fade and dull
+    like tape that has been bounced one time too many. The coefficients are the RBJ
+    cookbook low-pass of archive/plug-n-script/library/BiquadFilter.hxx.
+
+    The biquad is transposed direct form II with every loop channel in its own lane of a
+    fixed-width block, so one sample of all channels is a few vector operations and the
+    cost doesn't grow with the channel count.
+*/
+template <typename SampleType>
+class DecayFilter
+{
+public:
+    //==============================================================================
+    static constexpr int lanes = 8;                 // Channels filtered together
+    static constexpr float maxToneHz = 20000.0f;    // At or above: decay gain only
+
+    DecayFilter() = default;
+
+    void prepare(double sampleRate);
+    void reset() noexcept;
+
+    // Recomputes the coefficients only when a value changed
+    void setDecay(float gainDecibels, float toneHz) noexcept;
+
+    SampleType getGain() const noexcept { return gain; }
+    bool isFiltering() const noexcept { return filtering; }
+
+    // Decays numSamples of numChannels (<= lanes) channels, in the order the playhead meets
+    // them: from start in steps of step (1 or -1). The result is blended with the dry samples
+    // by a mix that ramps from startMix by mixStep per sample.
+    void process(SampleType* const* channels, int numChannels, int start, int numSamples, int step,
+                 float startMix, float mixStep) noexcept;
+
+private:
+    //==============================================================================
+    double sampleRate = 44100.0;
+    float appliedDecibels = 1.0f;   // Out of range, so the first setDecay() always computes
+    float appliedToneHz = -1.0f;
+
+    SampleType gain = SampleType(1);
+    bool filtering = false;
+    SampleType b0 = SampleType(1), b1 = SampleType(0), b2 = SampleType(0), a1 = SampleType(0), a2 = SampleType(0);
+
+    alignas(32) std::array<SampleType, lanes> state1 {};
+    alignas(32) std::array<SampleType, lanes> state2 {};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DecayFilter)
+};
@@ -0,0 +1,99 @@
+#include "HalfbandDecimator.h"
+#include <cmath>
+
+//==============================================================================
+template <typename SampleType>
+HalfbandDecimator<SampleType>::HalfbandDecimator()
+{
+    // Windowed sinc with its cutoff at the output Nyquist (a quarter of the input rate).
+    // Offsets an even distance from the centre land on sinc zeros; the rest are odd
+    // offsets, which sit on the even tap indices because numTaps / 2 is odd.
+    static_assert(centreTap % 2 == 1, "numTaps must be 4k - 1 so the non-zero taps are the even ones");
+
+    std::array<double, numTaps> coefficients {};
+    double sum = 0.0;
+
+    for (int tap = 0; tap < numTaps; ++tap)
+    {
+        const int offset = tap - centreTap;
+        const double x = juce::MathConstants<double>::halfPi * offset;
+        const double sinc = (offset == 0) ? 1.0 : std::sin(x) / x;
+
+        // Blackman window
+        const double w = juce::MathConstants<double>::twoPi * tap / (numTaps - 1);
+        const double window = 0.42 - 0.5 * std::cos(w) + 0.08 * std::cos(2.0 * w);
+
+        coefficients[static_cast<size_t>(tap)] = 0.5 * sinc * window;
+        sum += coefficients[static_cast<size_t>(tap)];
+    }
+
+    for (int tap = 0; tap < numTaps; tap += 2)
+        evenCoefficients[static_cast<size_t>(tap / 2)] = static_cast<SampleType>(coefficients[static_cast<size_t>(tap)] / sum);
+
+    centreCoefficient = static_cast<SampleType>(coefficients[static_cast<size_t>(centreTap)] / sum);
+}
+
+template <typename SampleType>
+void HalfbandDecimator<SampleType>::prepare(int numChannels, int maxInputSamples)
+{
+    work.resize(static_cast<size_t>(numChannels));
+
+    for (auto& channelWork : work)
+        channelWork.assign(static_cast<size_t>(numTaps - 1 + maxInputSamples), SampleType());
+
+    reset();
+}
+
+template <typename SampleType>
+void HalfbandDecimator<SampleType>::reset()
+{
+    for (auto& channelWork : work)
+        std::fill(channelWork.begin(), channelWork.end(), SampleType());
+
+    phase = 0;
+}
+
+template <typename SampleType>
+template <typename InputType>
+int HalfbandDecimator<SampleType>::process(int channel, const InputType* input, int numInput, SampleType* output) noexcept
+{
+    auto& channelWork = work[static_cast<size_t>(channel)];
+    jassert(numInput <= static_cast<int>(channelWork.size()) - (numTaps - 1));
+
+    SampleType* history = channelWork.data();
+    SampleType* block = history + (numTaps - 1);
+
+    for (int i = 0; i < numInput; ++i)
+        block[i] = static_cast<SampleType>(input[i]);
+
+    // Input n completes a pair (and produces an output) when phase + n is odd.
+    // The window for that output is history[n .. n + numTaps - 1].
+    constexpr int lanes = 4;
+    int numOutput = 0;
+
+    for (int n = 1 - phase; n < numInput; n += 2)
+    {
+        const SampleType* window = history + n;
+        SampleType sum[lanes] = {};
+
+        for (int tap = 0; tap < numEvenTaps; ++tap)
+            sum[tap % lanes] += evenCoefficients[static_cast<size_t>(tap)] * window[2 * tap];
+
+        output[numOutput++] = (sum[0] + sum[1]) + (sum[2] + sum[3]) + centreCoefficient * window[centreTap];
+    }
+
+    // Keep the newest numTaps - 1 samples as history for the next block
+    if (numInput > 0)
+        std::copy(history + numInput, history + numInput + (numTaps - 1), history);
+
+    return numOutput;
+}
+
+//==============================================================================
+template class HalfbandDecimator<float>;
+template class HalfbandDecimator<double>;
+
+template int HalfbandDecimator<float>::process<float>(int, const float*, int, float*) noexcept;
+template int HalfbandDecimator<float>::process<double>(int, const double*, int, float*) noexcept;
+template int HalfbandDecimator<double>::process<float>(int, const float*, int, double*) noexcept;
+template int HalfbandDecimator<double>::process<double>(int, const double*, int, double*) noexcept;
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <array>
+#include <vector>
+
+//==============================================================================
+/**
+    2:1 polyphase halfband decimator, used when recording in half-speed mode
+
+    A halfband lowpass has every other coefficient zero except the centre, so each
+    output costs one dot product over the even taps plus one multiply for the centre.
+    History and work space are allocated in prepare(); process() never allocates.
+
+    The filter delays the signal by (numTaps - 1) / 2 input samples.
+*/
+template <typename SampleType>
+class HalfbandDecimator
+{
+public:
+    //==============================================================================
+    static constexpr int numTaps = 31;
+    static constexpr int centreTap = numTaps / 2;
+    static constexpr int numEvenTaps = (numTaps + 1) / 2;
+
+    HalfbandDecimator();
+
+    void prepare(int numChannels, int maxInputSamples);
+    void reset();
+
+    // Filters numInput samples of one channel and writes every second one to output.
+    // Returns how many samples were written (numInput / 2, give or take the carried phase).
+    // Every channel gets the same input length; call advance() once all have been processed.
+    template <typename InputType>
+    int process(int channel, const InputType* input, int numInput, SampleType* output) noexcept;
+
+    void advance(int numInput) noexcept { phase = (phase + numInput) & 1; }
+
+private:
+    //==============================================================================
+    std::array<SampleType, numEvenTaps> evenCoefficients {};
+    SampleType centreCoefficient = SampleType(0.5);
+
+    // Per channel: [numTaps - 1 samples of history | current input block]
+    std::vector<std::vector<SampleType>> work;
+    int phase = 0;  // 1 when the last block ended halfway through an input pair
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(HalfbandDecimator)
+};
@@ -0,0 +1,90 @@
+#include "LevelMeter.h"
+#include <cmath>
+
+//==============================================================================
+void LevelMeter::prepare(double newSampleRate) noexcept
+{
+    sampleRate = newSampleRate;
+    reset();
+}
+
+void LevelMeter::reset() noexcept
+{
+    blockPeak = 0.0f;
+    blockMeanSquare = 0.0;
+    heldPeak = 0.0f;
+    meanSquare = 0.0;
+}
+
+//==============================================================================
+template <typename SampleType>
+void LevelMeter::measure(const SampleType* const* channels, int numChannels, int numSamples, float gain) noexcept
+{
+    if (numChannels <= 0 || numSamples <= 0)
+        return;
+
+    constexpr int lanes = 8;
+    SampleType peak[lanes] = {};
+    SampleType sum[lanes] = {};
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        const SampleType* data = channels[channel];
+        int i = 0;
+
+        // Independent lanes so the compiler can vectorize without reassociating
+        for (; i + lanes <= numSamples; i += lanes)
+        {
+            for (int lane = 0; lane < lanes; ++lane)
+            {
+                const SampleType x = data[i + lane];
+                peak[lane] = juce::jmax(peak[lane], std::abs(x));
+                sum[lane] += x * x;
+            }
+        }
+
+        for (; i < numSamples; ++i)
+        {
+            peak[i % lanes] = juce::jmax(peak[i % lanes], std::abs(data[i]));
+            sum[i % lanes] += data[i] * data[i];
+        }
+    }
+
+    SampleType maximum = 0;
+    double total = 0.0;
+    for (int lane = 0; lane < lanes; ++lane)
+    {
+        maximum = juce::jmax(maximum, peak[lane]);
+        total += static_cast<double>(sum[lane]);
+    }
+
+    const double gainSquared = static_cast<double>(gain) * static_cast<double>(gain);
+    add(static_cast<float>(maximum) * std::abs(gain), total * gainSquared, numChannels * numSamples);
+}
+
+void LevelMeter::add(float peak, double sumOfSquares, int numValues) noexcept
+{
+    if (numValues <= 0)
+        return;
+
+    blockPeak = juce::jmax(blockPeak, peak);
+    blockMeanSquare += sumOfSquares / static_cast<double>(numValues);
+}
+
+LevelMeter::Level LevelMeter::finishBlock(int numSamples) noexcept
+{
+    const double seconds = static_cast<double>(numSamples) / sampleRate;
+
+    // -60 dB over peakReleaseSeconds, and a one-pole average over rmsSeconds
+    const auto release = static_cast<float>(std::pow(0.001, seconds / peakReleaseSeconds));
+    heldPeak = juce::jmax(blockPeak, heldPeak * release);
+    meanSquare += (blockMeanSquare - meanSquare) * (1.0 - std::exp(-seconds / rmsSeconds));
+
+    blockPeak = 0.0f;
+    blockMeanSquare = 0.0;
+    return { heldPeak, static_cast<float>(std::sqrt(meanSquare)) };
+}
+
+//==============================================================================
+template void LevelMeter::measure<float>(const float* const*, int, int, float) noexcept;
+template void LevelMeter::measure<double>(const double* const*, int, int, float) noexcept;
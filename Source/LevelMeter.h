@@ -0,0 +1,57 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+//==============================================================================
+/**
+    Peak and RMS meter for one signal of the engine
+
+    The kernels add what they measure while a block is being processed - a span of
+    samples, or a peak and sum of squares they worked out themselves on the way through -
+    and finishBlock() turns the block's totals into display levels at the end of it.
+    The peak holds the block's maximum and falls back at peakReleaseSeconds per 60 dB;
+    the RMS is averaged over rmsSeconds, so the levels don't depend on how often they
+    are read. Audio thread only; the engine publishes the levels.
+*/
+class LevelMeter
+{
+public:
+    //==============================================================================
+    // Linear levels of one signal
+    struct Level
+    {
+        float peak = 0.0f;
+        float rms = 0.0f;
+    };
+
+    static constexpr double peakReleaseSeconds = 1.5;
+    static constexpr double rmsSeconds = 0.3;
+
+    LevelMeter() = default;
+
+    void prepare(double sampleRate) noexcept;
+    void reset() noexcept;
+
+    // Adds numSamples of each channel, scaled by gain, to this block
+    template <typename SampleType>
+    void measure(const SampleType* const* channels, int numChannels, int numSamples, float gain = 1.0f) noexcept;
+
+    // Adds a measurement the caller made itself. Signals added within a block sum in power,
+    // like the slots mixed into the loop output.
+    void add(float peak, double sumOfSquares, int numValues) noexcept;
+
+    // Ends the block of numSamples and returns the levels after it
+    Level finishBlock(int numSamples) noexcept;
+
+private:
+    //==============================================================================
+    double sampleRate = 44100.0;
+
+    float blockPeak = 0.0f;
+    double blockMeanSquare = 0.0;
+
+    float heldPeak = 0.0f;
+    double meanSquare = 0.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LevelMeter)
+};
@@ -0,0 +1,227 @@
+#include "LoopPages.h"
+#include <algorithm>
+#include <limits>
+
+//==============================================================================
+void LoopPages::prepare(int maxTakeSamples)
+{
+    // Levels never overlap, so together they need at most one page per pageSize samples of
+    // take, plus a partial last page each
+    isPageReal.assign(static_cast<size_t>(maxTakeSamples / pageSize + maxLevels + 1), 0);
+    reset();
+}
+
+bool LoopPages::addRepeats(int origin, int from, int to) noexcept
+{
+    return !growsDownwards() && addLevel(origin, from, to);
+}
+
+bool LoopPages::addRepeatsBelow(int from, int origin, int end, int newTakeLength) noexcept
+{
+    jassert(from >= 0 && from < origin && origin < end && end <= newTakeLength);
+
+    if (!isIdentity() && !growsDownwards())
+        return false;
+
+    // The end of the take stays put, so the levels already there keep their map positions
+    const int previousEnd = takeEnd;
+    takeEnd = newTakeLength;
+
+    if (addLevel(takeEnd - end, takeEnd - origin, takeEnd - from))
+        return true;
+
+    takeEnd = previousEnd;
+    return false;
+}
+
+bool LoopPages::addLevel(int origin, int from, int to) noexcept
+{
+    jassert(origin >= 0 && origin < from && from < to);
+
+    // Whatever lay past from is replaced by the new repeats
+    while (numLevels > 0 && levels[static_cast<size_t>(numLevels - 1)].from >= from)
+        --numLevels;
+
+    int firstPage = 0;
+
+    if (numLevels > 0)
+    {
+        auto& last = levels[static_cast<size_t>(numLevels - 1)];
+        last.to = juce::jmin(last.to, from);
+        firstPage = last.firstPage + (last.to - last.from + pageSize - 1) / pageSize;
+    }
+
+    const int numPages = (to - from + pageSize - 1) / pageSize;
+
+    if (numLevels == maxLevels || firstPage + numPages > static_cast<int>(isPageReal.size()))
+        return false;
+
+    std::fill_n(isPageReal.begin() + firstPage, numPages, std::uint8_t(0));
+    levels[static_cast<size_t>(numLevels++)] = { origin, from, to, firstPage };
+    return true;
+}
+
+const LoopPages::Level* LoopPages::findLevel(int position) const noexcept
+{
+    for (int i = numLevels - 1; i >= 0; --i)
+    {
+        const auto& level = levels[static_cast<size_t>(i)];
+
+        if (position >= level.from)
+            return (position < level.to) ? &level : nullptr;
+    }
+
+    return nullptr;
+}
+
+bool LoopPages::isReal(int position) const noexcept
+{
+    const auto* level = findLevel(toMap(position));
+    return level == nullptr || isPageReal[static_cast<size_t>(getPageIndex(*level, toMap(position)))] != 0;
+}
+
+int LoopPages::resolve(int position) const noexcept
+{
+    // Mapping is its own inverse
+    return toMap(resolveMapped(toMap(position)));
+}
+
+int LoopPages::getRunLength(int position, int direction) const noexcept
+{
+    // Counting back from the end turns the direction around too
+    return getMappedRunLength(toMap(position), growsDownwards() ? -direction : direction);
+}
+
+int LoopPages::resolveMapped(int position) const noexcept
+{
+    // Each step lands before the level's from, so this ends within numLevels steps
+    for (;;)
+    {
+        const auto* level = findLevel(position);
+
+        if (level == nullptr || isPageReal[static_cast<size_t>(getPageIndex(*level, position))] != 0)
+            return position;
+
+        position = level->origin + (position - level->origin) % (level->from - level->origin);
+    }
+}
+
+int LoopPages::getMappedRunLength(int position, int direction) const noexcept
+{
+    int run = std::numeric_limits<int>::max();
+
+    for (;;)
+    {
+        const auto* level = findLevel(position);
+
+        if (level == nullptr)
+        {
+            // Real up to the first level (or past the end of the take, where nothing is mapped)
+            if (numLevels > 0 && position < levels[0].from)
+                run = juce::jmin(run, (direction > 0) ? levels[0].from - position : position + 1);
+
+            return run;
+        }
+
+        const int pageStart = getPageStart(*level, position);
+        const int pageEnd = juce::jmin(pageStart + pageSize, level->to);
+
+        if (isPageReal[static_cast<size_t>(getPageIndex(*level, position))] != 0)
+            return juce::jmin(run, (direction > 0) ? pageEnd - position : position - pageStart + 1);
+
+        // Virtual: contiguous to the end of the page or of this repeat, whichever is nearer,
+        // and then only as far as the audio it repeats is
+        const int period = level->from - level->origin;
+        const int offset = (position - level->origin) % period;
+        const int repeatStart = position - offset;
+
+        if (direction > 0)
+            run = juce::jmin(run, juce::jmin(pageEnd, repeatStart + period) - position);
+        else
+            run = juce::jmin(run, position - juce::jmax(pageStart, repeatStart) + 1);
+
+        position = level->origin + offset;
+    }
+}
+
+template <typename SampleType>
+void LoopPages::materialize(SampleType* const* take, int numChannels, int from, int numSamples) noexcept
+{
+    if (growsDownwards())
+        from = takeEnd - from - numSamples;
+
+    const int end = from + numSamples;
+
+    // The repeats of the range first, while they still read what's there now
+    for (int i = 0; i < numLevels; ++i)
+    {
+        const auto& level = levels[static_cast<size_t>(i)];
+        const int repeatedFrom = juce::jmax(from, level.origin);
+        const int repeatedEnd = juce::jmin(end, level.from);
+        const int period = level.from - level.origin;
+
+        if (repeatedFrom >= repeatedEnd)
+            continue;
+
+        for (int offset = period; repeatedFrom + offset < level.to; offset += period)
+            materializePages(take, numChannels, repeatedFrom + offset, juce::jmin(repeatedEnd + offset, level.to));
+    }
+
+    materializePages(take, numChannels, from, end);
+}
+
+template <typename SampleType>
+void LoopPages::materializePages(SampleType* const* take, int numChannels, int from, int end) noexcept
+{
+    int position = from;
+
+    while (position < end)
+    {
+        const auto* level = findLevel(position);
+
+        if (level == nullptr)
+        {
+            // Already real: skip ahead to the first level, if it's still to come
+            if (numLevels == 0 || position >= levels[0].from)
+                return;
+
+            position = levels[0].from;
+            continue;
+        }
+
+        const int pageStart = getPageStart(*level, position);
+        const int pageEnd = juce::jmin(pageStart + pageSize, level->to);
+        auto& pageIsReal = isPageReal[static_cast<size_t>(getPageIndex(*level, position))];
+
+        if (pageIsReal == 0)
+        {
+            // The audio a virtual page repeats always lies before the level, so it never overlaps
+            for (int copied = pageStart; copied < pageEnd;)
+            {
+                const int run = juce::jmin(getMappedRunLength(copied, 1), pageEnd - copied);
+                int source = resolveMapped(copied);
+                int destination = copied;
+
+                // Counted back from the end, a run's first sample is its highest
+                if (growsDownwards())
+                {
+                    source = takeEnd - source - run;
+                    destination = takeEnd - destination - run;
+                }
+
+                for (int channel = 0; channel < numChannels; ++channel)
+                    std::copy_n(take[channel] + source, run, take[channel] + destination);
+
+                copied += run;
+            }
+
+            pageIsReal = 1;
+        }
+
+        position = pageEnd;
+    }
+}
+
+//==============================================================================
+template void LoopPages::materialize<float>(float* const*, int, int, int) noexcept;
+template void LoopPages::materialize<double>(double* const*, int, int, int) noexcept;
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+//==============================================================================
+/**
+    Copy-on-write page map for a multiplied loop
+
+    Multiplying a loop doesn't copy it. The take is extended with a level of virtual
+    repeats: a position in [from, to) reads the loop [origin, from) it repeats, and
+    levels can stack when a multiplied loop is multiplied again. Each level's span is
+    split into pages; a page becomes real (a copy at its own position) the first time
+    something writes to it, so an overdub only ever copies the pages it lands on.
+
+    Positions are relative to the start of the take. Real positions read in place and
+    virtual ones resolve to the real position holding their audio. A take with no room
+    above it (a reverse recording ends at the top of its buffer) is extended downwards
+    instead, with addRepeatsBelow(): the map then works on positions counted back from
+    the end of the take, where the repeats follow the loop just the same.
+    Audio thread only; the page table is allocated in prepare().
+*/
+class LoopPages
+{
+public:
+    //==============================================================================
+    static constexpr int pageSize = 4096;
+    static constexpr int maxLevels = 8;
+
+    LoopPages() = default;
+
+    void prepare(int maxTakeSamples);
+
+    // Back to a plain take, with every position real
+    void reset() noexcept { numLevels = 0; takeEnd = 0; }
+    bool isIdentity() const noexcept { return numLevels == 0; }
+    bool growsDownwards() const noexcept { return takeEnd > 0; }
+
+    // Ends the take at from and extends it to to with repeats of [origin, from).
+    // Returns false if there's no level left for it, or the map already grows downwards.
+    bool addRepeats(int origin, int from, int to) noexcept;
+
+    // Starts the take at from, below [origin, end), with repeats of that range down to it.
+    // Positions, from's included, are relative to the new start of the take, which ends at
+    // newTakeLength. Returns false if there's no level left, or the map grows upwards.
+    bool addRepeatsBelow(int from, int origin, int end, int newTakeLength) noexcept;
+
+    bool isReal(int position) const noexcept;
+
+    // Where position's audio is stored
+    int resolve(int position) const noexcept;
+
+    // How many positions from position on (direction 1) or down to it (-1), itself included,
+    // resolve to consecutive storage
+    int getRunLength(int position, int direction) const noexcept;
+
+    // Makes every page in [from, from + numSamples) real, along with every virtual page that
+    // repeats audio in it, so the range can be written without the repeats hearing the write.
+    // take holds each channel's take start.
+    template <typename SampleType>
+    void materialize(SampleType* const* take, int numChannels, int from, int numSamples) noexcept;
+
+private:
+    //==============================================================================
+    struct Level
+    {
+        int origin = 0;
+        int from = 0;
+        int to = 0;
+        int firstPage = 0;  // Index of the level's first page in isPageReal
+    };
+
+    // The private functions work on map positions: take positions, or for a map that grows
+    // downwards, positions counted back from takeEnd
+    int toMap(int position) const noexcept { return (takeEnd > 0) ? takeEnd - 1 - position : position; }
+
+    bool addLevel(int origin, int from, int to) noexcept;
+    const Level* findLevel(int position) const noexcept;
+    int resolveMapped(int position) const noexcept;
+    int getMappedRunLength(int position, int direction) const noexcept;
+
+    template <typename SampleType>
+    void materializePages(SampleType* const* take, int numChannels, int from, int end) noexcept;
+    int getPageIndex(const Level& level, int position) const noexcept { return level.firstPage + (position - level.from) / pageSize; }
+    int getPageStart(const Level& level, int position) const noexcept { return level.from + ((position - level.from) / pageSize) * pageSize; }
+
+    std::array<Level, maxLevels> levels {};
+    int numLevels = 0;
+    int takeEnd = 0;    // Take length, if the map grows downwards (0 = upwards)
+    std::vector<std::uint8_t> isPageReal;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LoopPages)
+};
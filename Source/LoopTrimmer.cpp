@@ -0,0 +1,101 @@
+#include "LoopTrimmer.h"
+
+//==============================================================================
+LoopTrimmer::LoopTrimmer(std::function<void()> scanPendingTakesToUse)
+    : juce::Thread("Boomerang Loop Trimmer"),
+      scanPendingTakes(std::move(scanPendingTakesToUse))
+{
+}
+
+LoopTrimmer::~LoopTrimmer()
+{
+    stop();
+}
+
+void LoopTrimmer::start()
+{
+    if (!isThreadRunning())
+        startThread(juce::Thread::Priority::low);
+}
+
+void LoopTrimmer::stop()
+{
+    stopThread(pollIntervalMs * 10);
+}
+
+void LoopTrimmer::run()
+{
+    // Polled rather than notified, so flagging a take from the audio thread is a plain atomic store
+    while (!threadShouldExit())
+    {
+        scanPendingTakes();
+        wait(pollIntervalMs);
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+LoopTrimmer::Markers LoopTrimmer::findAudibleRegion(const SampleType* const* channels, int numChannels, int numSamples, double sampleRate) noexcept
+{
+    const int window = juce::jmax(1, juce::roundToInt(sampleRate * windowSeconds));
+
+    // Head: the first window with anything in it
+    int firstLoud = 0;
+    while (firstLoud < numSamples && isWindowSilent(channels, numChannels, firstLoud, juce::jmin(window, numSamples - firstLoud)))
+        firstLoud += window;
+
+    if (firstLoud >= numSamples)
+        return {};
+
+    // Tail: windows counted back from the end, so the last partial window is at the head
+    int lastLoudEnd = numSamples;
+    while (lastLoudEnd > firstLoud)
+    {
+        const int windowStart = juce::jmax(firstLoud, lastLoudEnd - window);
+        if (!isWindowSilent(channels, numChannels, windowStart, lastLoudEnd - windowStart))
+            break;
+
+        lastLoudEnd = windowStart;
+    }
+
+    const int start = juce::jmax(0, firstLoud - juce::roundToInt(sampleRate * attackMarginSeconds));
+    const int end = juce::jmin(numSamples, lastLoudEnd + juce::roundToInt(sampleRate * releaseMarginSeconds));
+    return { start, end - start };
+}
+
+template <typename SampleType>
+bool LoopTrimmer::isWindowSilent(const SampleType* const* channels, int numChannels, int startSample, int numSamples) noexcept
+{
+    // Sum of squares against the threshold's, so there's no division or square root per window
+    const auto threshold = static_cast<SampleType>(silenceThreshold);
+    const SampleType limit = threshold * threshold * static_cast<SampleType>(numSamples);
+    constexpr int lanes = 8;
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        const SampleType* data = channels[channel] + startSample;
+        SampleType sum[lanes] = {};
+        int i = 0;
+
+        // Independent lanes so the compiler can vectorize without reassociating
+        for (; i + lanes <= numSamples; i += lanes)
+            for (int lane = 0; lane < lanes; ++lane)
+                sum[lane] += data[i + lane] * data[i + lane];
+
+        for (; i < numSamples; ++i)
+            sum[i % lanes] += data[i] * data[i];
+
+        SampleType total = 0;
+        for (int lane = 0; lane < lanes; ++lane)
+            total += sum[lane];
+
+        if (total > limit)
+            return false;
+    }
+
+    return true;
+}
+
+//==============================================================================
+template LoopTrimmer::Markers LoopTrimmer::findAudibleRegion<float>(const float* const*, int, int, double) noexcept;
+template LoopTrimmer::Markers LoopTrimmer::findAudibleRegion<double>(const double* const*, int, int, double) noexcept;
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <cstdint>
+#include <functional>
+
+//==============================================================================
+/**
+    Background worker that finds the audible part of a finished take
+
+    The engine flags a take when recording stops and the worker thread wakes every
+    pollIntervalMs to call the engine's scan callback off the audio thread. The scan
+    measures the RMS of short windows from each end of the take and proposes markers
+    that drop the silence at the head and tail. The audio thread only ever picks up a
+    packed proposal with one atomic exchange - it never scans or waits on this thread.
+*/
+class LoopTrimmer : private juce::Thread
+{
+public:
+    //==============================================================================
+    // The audible region of a take, relative to the take's first sample
+    struct Markers
+    {
+        int start = 0;
+        int length = 0;
+
+        // Both halves in one word, so a proposal is published and taken atomically (0 = none)
+        std::uint64_t pack() const noexcept { return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(start)) << 32) | static_cast<std::uint32_t>(length); }
+        static Markers unpack(std::uint64_t packed) noexcept { return { static_cast<int>(packed >> 32), static_cast<int>(packed & 0xffffffffu) }; }
+    };
+
+    static constexpr int pollIntervalMs = 50;
+    static constexpr double windowSeconds = 0.005;          // RMS window
+    static constexpr float silenceThreshold = 0.001f;       // -60 dBFS RMS
+    static constexpr double attackMarginSeconds = 0.005;    // Kept before the first loud window
+    static constexpr double releaseMarginSeconds = 0.05;    // Kept after the last one, for the decay
+
+    explicit LoopTrimmer(std::function<void()> scanPendingTakes);
+    ~LoopTrimmer() override;
+
+    void start();
+    void stop();
+
+    // Audible region of a take's numSamples, or length 0 if it is silent throughout
+    template <typename SampleType>
+    static Markers findAudibleRegion(const SampleType* const* channels, int numChannels, int numSamples, double sampleRate) noexcept;
+
+private:
+    //==============================================================================
+    void run() override;
+
+    template <typename SampleType>
+    static bool isWindowSilent(const SampleType* const* channels, int numChannels, int startSample, int numSamples) noexcept;
+
+    std::function<void()> scanPendingTakes;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LoopTrimmer)
+};
@@ -1,5 +1,6 @@
 #include "LooperEngine.h"
 #include "PluginProcessor.h"  // For ParameterIDs
+#include <thread>
 
 //==============================================================================
 LooperEngine::LooperEngine()
@@ -8,30 +9,89 @@ LooperEngine::LooperEngine()
 
 LooperEngine::~LooperEngine()
 {
+    loopTrimmer.stop();
 }
 
 //==============================================================================
 void LooperEngine::prepare(double newSampleRate, int newSamplesPerBlock, int newNumChannels)
 {
+    jassert(newNumChannels > 0 && newNumChannels <= maxChannels);
+
+    // The trim worker reads the slot buffers, which are about to be reallocated
+    loopTrimmer.stop();
+
     sampleRate = newSampleRate;
     samplesPerBlock = newSamplesPerBlock;
-    numChannels = newNumChannels;
+    numChannels = juce::jlimit(1, maxChannels, newNumChannels);
     maxLoopSamples = static_cast<int>(sampleRate * maxLoopLengthSeconds);
 
+    // Scratch for the block kernels - processBlock() never hands them more than samplesPerBlock
+    floatBuffers.scratch.setSize(numChannels, samplesPerBlock);
+    doubleBuffers.scratch.setSize(numChannels, samplesPerBlock);
+    blockIndex.calloc(static_cast<size_t>(samplesPerBlock));
+    blockSource.calloc(static_cast<size_t>(samplesPerBlock));
+    blockWeights.calloc(static_cast<size_t>(samplesPerBlock * SincTable::numTaps));
+    recordDecimator.prepare(numChannels, samplesPerBlock);
+    decimatedInput.calloc(static_cast<size_t>(samplesPerBlock / 2 + 1));
+    timeStretchLoad.reset(sampleRate, samplesPerBlock);
+    decayFilter.prepare(sampleRate);
+
+    // 1 ms raised-cosine fades for the loop seam; the punch ramps use the same length
+    fadeSamples = juce::jmax(1, juce::roundToInt(sampleRate * fadeLengthSeconds));
+    fadeInTable.calloc(static_cast<size_t>(fadeSamples));
+    fadeOutTable.calloc(static_cast<size_t>(fadeSamples));
+
+    for (int i = 0; i < fadeSamples; ++i)
+    {
+        const float phase = (static_cast<float>(i) + 0.5f) / static_cast<float>(fadeSamples);
+        fadeInTable[i] = 0.5f - 0.5f * std::cos(juce::MathConstants<float>::pi * phase);
+        fadeOutTable[fadeSamples - 1 - i] = fadeInTable[i];
+    }
+
+    for (auto& stretcher : timeStretchers)
+        stretcher.prepare(numChannels);
+
+    inputMeter.prepare(sampleRate);
+    loopMeter.prepare(sampleRate);
+    outputMeter.prepare(sampleRate);
+
+    for (auto& slot : loopSlots)
+    {
+        slot.pages.prepare(maxLoopSamples);
+        slot.overview.prepare(maxLoopSamples);
+    }
+
+    // Both halves of the mirrored ring at the current capture length; any ring-sized buffer
+    // a slot held is reallocated below, so the ring owns it again
+    captureRing.setSize(numChannels, 2 * getCaptureCapacity());
+    captureRing.clear();
+    captureCapacity = 0;
+    captureBufferOwner = -1;
+    captureRingSamples.store(captureRing.getNumSamples());
+    resizedCaptureRing = juce::AudioBuffer<StorageType>();
+    captureRingResized.store(false);
+
     // Initialize all loop slots
     for (auto& slot : loopSlots)
     {
         slot.buffer.setSize(numChannels, maxLoopSamples);
         slot.buffer.clear();
+        slot.takeStart.store(0);
+        slot.takeLength.store(0);
+        slot.loopStart.store(0);
         slot.length.store(0);
         slot.hasContent.store(false);
         slot.isRecording.store(false);
         slot.isPlaying.store(false);
-        slot.playPosition.store(0.0f);
-        slot.recordPosition.store(0.0f);
+        slot.playPosition.store(0.0);
+        slot.recordPosition.store(0.0);
+        slot.speed.store(1.0f);
+        slot.direction.store(LoopMode::Normal);
+        slot.syncLengthPpq.store(0.0);
     }
 
     reset();
+    loopTrimmer.start();
 }
 
 void LooperEngine::reset()
@@ -44,23 +104,103 @@ void LooperEngine::reset()
     thruMute = ThruMuteState::Off;
     speedMode = SpeedMode::Normal;
     activeLoopSlot = 0;
+    pendingSyncAction = SyncAction::None;
+    syncActionPpq = -1.0;
 
     for (auto& slot : loopSlots)
     {
         slot.buffer.clear();
+        slot.takeStart.store(0);
+        slot.takeLength.store(0);
+        slot.loopStart.store(0);
         slot.length.store(0);
         slot.hasContent.store(false);
         slot.isRecording.store(false);
         slot.isPlaying.store(false);
-        slot.playPosition.store(0.0f);
-        slot.recordPosition.store(0.0f);
+        slot.playPosition.store(0.0);
+        slot.recordPosition.store(0.0);
+        slot.speed.store(1.0f);
+        slot.direction.store(LoopMode::Normal);
+        slot.syncLengthPpq.store(0.0);
+        slot.trimRequested.store(false);
+        slot.seamFade.store(0);
+        slot.pendingMarkers.store(0);
+        slot.pendingMultiply.store(0);
+        slot.pendingDivide.store(0);
+        slot.pagesStale.store(true);
+        slot.overviewStale.store(true);
+        ++slot.takeRevision;
     }
 }
 
 //==============================================================================
-void LooperEngine::processBlock(juce::AudioBuffer<float>& buffer)
+template <typename SampleType>
+void LooperEngine::processBlock(juce::AudioBuffer<SampleType>& buffer, SlotOutputs<SampleType>* slotOutputs)
+{
+    const int totalSamples = buffer.getNumSamples();
+
+    hostSyncAvailable.store(hostTransport.hasTempo && hostTransport.bpm > 0.0
+                            && hostTransport.hasPpq && hostTransport.isPlaying);
+    followHostTransport();
+
+    // The kernels' scratch is sized for samplesPerBlock. If the host sends a larger
+    // block, walk it in chunks that refer to the host's channel data (no copy).
+    // A pending bar/beat-quantized action also splits the block, so it lands on its exact sample.
+    for (int start = 0; start < totalSamples;)
+    {
+        int chunkSamples = juce::jmin(samplesPerBlock, totalSamples - start);
+        const int syncActionOffset = getSyncActionOffset(start, chunkSamples);
+
+        if (syncActionOffset == 0 && performSyncAction())
+            continue;
+
+        if (syncActionOffset > 0)
+            chunkSamples = syncActionOffset;
+
+        // Automation: apply what's due here, and end this sub-block at the next event
+        applyAutomationEvents(start);
+        const int automationOffset = getAutomationOffset(start, chunkSamples);
+
+        if (automationOffset > 0)
+            chunkSamples = automationOffset;
+
+        // Capture before this chunk's input reaches the ring, so the loop ends right here
+        if (captureRequested.exchange(false))
+            captureIntoActiveSlot(start);
+
+        applyPendingMarkers();
+        lockSlotsToHost(start);
+        bindSlotOutputs(slotOutputs, start, chunkSamples);
+
+        if (chunkSamples == totalSamples)
+        {
+            writeCaptureRing(buffer);
+            processChunk(buffer);
+        }
+        else
+        {
+            juce::AudioBuffer<SampleType> chunk(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), start, chunkSamples);
+            writeCaptureRing(chunk);
+            processChunk(chunk);
+        }
+
+        clearUnwrittenSlotOutputs<SampleType>();
+        start += chunkSamples;
+    }
+
+    finishAutomationEvents();
+    publishStateSnapshot();
+}
+
+template <typename SampleType>
+void LooperEngine::processChunk(juce::AudioBuffer<SampleType>& buffer)
 {
     auto& activeSlot = loopSlots[static_cast<size_t>(activeLoopSlot.load())];
+    const int numSamples = buffer.getNumSamples();
+    const int channels = juce::jmin(numChannels, buffer.getNumChannels());
+
+    // The input, before the kernels replace it with the output
+    inputMeter.measure(buffer.getArrayOfReadPointers(), channels, numSamples);
 
     // Thread-safe state access (issue #38)
     auto state = currentState.load();
@@ -74,6 +214,10 @@ void LooperEngine::processBlock(juce::AudioBuffer<float>& buffer)
             // Otherwise pass-through audio when stopped
             break;
 
+        case LooperState::Armed:
+            processArmed(buffer, activeSlot);
+            break;
+
         case LooperState::Recording:
             processRecording(buffer, activeSlot);
             break;
@@ -87,11 +231,23 @@ void LooperEngine::processBlock(juce::AudioBuffer<float>& buffer)
             break;
 
         case LooperState::ContinuousReverse:
+            processContinuousReverse(buffer, activeSlot);
+            break;
+
         case LooperState::BufferFilled:
-            // No processing defined yet
+            // The full take plays on until Record or Play decides what happens to it
+            processPlayback(buffer, activeSlot);
             break;
     }
+
+    // Multi-track: every other recorded slot plays along with whatever the active slot is doing
+    if (playbackMode.load() == PlaybackMode::MultiTrack && state != LooperState::Stopped)
+        processMultiTrackPlayback(buffer);
+
     // Note: Volume is applied to loop signal only in processPlayback/processOverdubbing (issue #44)
+
+    outputMeter.measure(buffer.getArrayOfReadPointers(), channels, numSamples);
+    currentMeterLevels = { inputMeter.finishBlock(numSamples), loopMeter.finishBlock(numSamples), outputMeter.finishBlock(numSamples) };
 }
 
 //==============================================================================
@@ -122,34 +278,55 @@ void LooperEngine::onRecordButtonPressed()
     switch (state)
     {
         case LooperState::Stopped:
-            // Start recording first loop
-            startRecording();
+            // Start recording first loop (or wait for input, with auto-start)
+            startOrArmRecording();
+            break;
+
+        case LooperState::Armed:
+            // Second press gives up waiting
+            cancelArmedRecording();
             break;
 
         case LooperState::Recording:
             // Check if we've recorded anything yet
             if (activeSlot.recordPosition.load() > 0) 
             {
+                // Host sync: the audio thread stops on the next bar/beat boundary
+                if (canSyncToHost())
+                {
+                    pendingSyncAction.store(SyncAction::StopRecordingAndPlay);
+                    break;
+                }
+
                 // Stop recording, start playback
                 stopRecording();
-                startPlayback();
+                startPlaybackAfterRecording();
             }
             break;
 
         case LooperState::Playing:
+        case LooperState::ContinuousReverse:
+        case LooperState::BufferFilled:
+            // Multi-track: keep this loop and layer the new recording in the next empty slot.
+            // With every slot recorded there's nowhere to put it, so the loops play on.
+            if (playbackMode.load() == PlaybackMode::MultiTrack && findNextEmptyLoopSlot() < 0)
+            {
+                if (parameterNotifyCallback)
+                    parameterNotifyCallback(ParameterIDs::record, (state == LooperState::ContinuousReverse) ? 1.0f : 0.0f);
+                break;
+            }
+
             // Stop playing and start new recording
             stopPlayback();
-            startRecording();
+            if (playbackMode.load() == PlaybackMode::MultiTrack)
+                switchToLoopSlot(findNextEmptyLoopSlot());
+            startOrArmRecording();
             break;
 
         case LooperState::Overdubbing:
             // Stop overdubbing, continue playing
             stopOverdubbing();
             break;
-
-        case LooperState::ContinuousReverse:
-        case LooperState::BufferFilled:
-            break;
     }
     
     stateTransitionInProgress.store(false);
@@ -170,19 +347,41 @@ void LooperEngine::onPlayButtonPressed()
         case LooperState::Stopped:
             if (activeSlot.hasContent.load())
             {
+                // Following the host: start on the next bar/beat (a second press cancels)
+                if (canFollowHost())
+                {
+                    auto pending = pendingSyncAction.load();
+                    pendingSyncAction.store((pending == SyncAction::StartPlayback) ? SyncAction::None
+                                                                                   : SyncAction::StartPlayback);
+                    break;
+                }
+
+                // Multi-track: all tracks start together from their loop starts
+                if (playbackMode.load() == PlaybackMode::MultiTrack)
+                    restartAllSlots();
                 startPlayback();
             }
             break;
 
+        case LooperState::Armed:
+            cancelArmedRecording();
+            break;
+
         case LooperState::Recording:
-            // Stop recording, go idle
-            stopRecording();
+            // Stop recording, go idle (on the next bar/beat boundary when synced)
+            if (canSyncToHost())
+                pendingSyncAction.store(SyncAction::StopRecording);
+            else
+                stopRecording();
             break;
 
         case LooperState::Playing:
         case LooperState::Overdubbing:
-            // Stop playback
-            stopPlayback();
+            // Stop playback (on the next bar/beat when following the host)
+            if (canFollowHost())
+                pendingSyncAction.store(SyncAction::StopPlayback);
+            else
+                stopPlayback();
             break;
 
         case LooperState::ContinuousReverse:
@@ -191,6 +390,12 @@ void LooperEngine::onPlayButtonPressed()
             break;
 
         case LooperState::BufferFilled:
+            // Keep the take, which has been playing since memory ran out, and tell the host
+            // it's playing as startPlayback() would (the press has toggled its Play)
+            currentState.store(LooperState::Playing);
+
+            if (parameterNotifyCallback)
+                parameterNotifyCallback(ParameterIDs::play, 1.0f);
             break;
     }
     
@@ -285,20 +490,89 @@ void LooperEngine::onReverseButtonPressed()
         return;  // Another thread is already processing a button press
     
     toggleDirection();
+
+    // Direction off ends continuous reverse: the loop plays on as it was last written
+    if (currentState.load() == LooperState::ContinuousReverse)
+    {
+        loopSlots[static_cast<size_t>(activeLoopSlot.load())].isRecording.store(false);
+        currentState.store(LooperState::Playing);
+    }
     
     stateTransitionInProgress.store(false);
 }
 
+void LooperEngine::onCaptureButtonPressed()
+{
+    // The audio thread owns the ring, so it performs the capture at its next chunk
+    if (captureSeconds.load() > 0)
+        captureRequested.store(true);
+}
+
+//==============================================================================
+void LooperEngine::selectLoopSlot(int slotIndex)
+{
+    if (! juce::isPositiveAndBelow(slotIndex, maxLoopSlots) || slotIndex == activeLoopSlot.load())
+        return;
+
+    // Thread safety: Only allow one state transition at a time
+    bool expected = false;
+    if (!stateTransitionInProgress.compare_exchange_strong(expected, true))
+        return;
+
+    auto state = currentState.load();
+
+    // Don't pull the slot out from under a recording in progress
+    if (state != LooperState::Recording && state != LooperState::Overdubbing && state != LooperState::ContinuousReverse)
+    {
+        activeLoopSlot.store(slotIndex);
+        auto& newSlot = loopSlots[static_cast<size_t>(slotIndex)];
+
+        // The direction/speed controls follow the newly selected slot
+        auto newLoop = newSlot.direction.load();
+        loopMode.store(newLoop);
+        currentDirection.store((newLoop == LoopMode::Reverse) ? DirectionMode::Reverse : DirectionMode::Forward);
+        speedMode.store((newSlot.speed.load() < 1.0f) ? SpeedMode::Half : SpeedMode::Normal);
+
+        if ((state == LooperState::Playing || state == LooperState::BufferFilled) && !newSlot.hasContent.load())
+            stopPlayback();
+
+        if (parameterNotifyCallback)
+        {
+            parameterNotifyCallback(ParameterIDs::reverse, (newLoop == LoopMode::Reverse) ? 1.0f : 0.0f);
+            parameterNotifyCallback(ParameterIDs::slowMode, (speedMode.load() == SpeedMode::Half) ? 1.0f : 0.0f);
+        }
+    }
+
+    stateTransitionInProgress.store(false);
+}
+
+void LooperEngine::setSlotGain(int slotIndex, float gain)
+{
+    if (juce::isPositiveAndBelow(slotIndex, maxLoopSlots))
+        loopSlots[static_cast<size_t>(slotIndex)].gain.store(gain);
+}
+
 //==============================================================================
 void LooperEngine::startRecording()
 {
     auto& activeSlot = loopSlots[static_cast<size_t>(activeLoopSlot.load())];
     
     activeSlot.isRecording.store(true);
+    activeSlot.loopStart.store(0);
+    activeSlot.trimRequested.store(false);
+    activeSlot.seamFade.store(0);
+    activeSlot.pagesStale.store(true);
+    ++activeSlot.takeRevision;
+    activeSlot.syncLengthPpq.store(0.0);  // Free-running until a synced stop says otherwise
+    // Direction changes during the take only affect how it plays back
+    recordDirection.store(loopMode.load());
+    activeSlot.direction.store(loopMode.load());
+    activeSlot.speed.store(getSpeedMultiplier());
+    recordDecimatorNeedsReset.store(true);  // Don't filter the new take with the last one's history
     // Start at end if reverse, beginning if forward
-    activeSlot.recordPosition.store((loopMode.load() == LoopMode::Reverse) 
-        ? static_cast<float>(maxLoopSamples - 1) 
-        : 0.0f);
+    activeSlot.recordPosition.store((recordDirection.load() == LoopMode::Reverse) 
+        ? static_cast<double>(maxLoopSamples - 1) 
+        : 0.0);
     currentState.store(LooperState::Recording);
     
     // Notify host that record button is on
@@ -306,19 +580,55 @@ void LooperEngine::startRecording()
         parameterNotifyCallback(ParameterIDs::record, 1.0f);
 }
 
+void LooperEngine::armRecording()
+{
+    currentState.store(LooperState::Armed);
+
+    // The record LED is on while armed
+    if (parameterNotifyCallback)
+        parameterNotifyCallback(ParameterIDs::record, 1.0f);
+}
+
+void LooperEngine::startOrArmRecording()
+{
+    if (autoStart.load())
+        armRecording();
+    else
+        startRecording();
+}
+
+void LooperEngine::cancelArmedRecording()
+{
+    currentState.store(LooperState::Stopped);
+
+    if (parameterNotifyCallback)
+        parameterNotifyCallback(ParameterIDs::record, 0.0f);
+}
+
 void LooperEngine::stopRecording()
 {
     auto& activeSlot = loopSlots[static_cast<size_t>(activeLoopSlot.load())];
     
     activeSlot.isRecording.store(false);
+    pendingSyncAction.store(SyncAction::None);
     
-    // Calculate recorded length based on direction
+    // Calculate recorded length based on direction. A reverse take is written down from
+    // the end of the buffer, so it starts just above the record position.
     int finalLength = static_cast<int>(activeSlot.recordPosition.load());
-    if (loopMode.load() == LoopMode::Reverse)
+    int finalStart = 0;
+    if (recordDirection.load() == LoopMode::Reverse)
+    {
         finalLength = (maxLoopSamples - 1) - finalLength;
+        finalStart = maxLoopSamples - finalLength;
+    }
     
+    activeSlot.takeStart.store(finalStart);
+    activeSlot.takeLength.store(finalLength);
+    activeSlot.loopStart.store(finalStart);
     activeSlot.length.store(finalLength);
     activeSlot.hasContent.store(finalLength > 0);
+    activeSlot.seamFade.store(LoopTrimmer::Markers { finalStart, finalLength }.pack());
+    activeSlot.trimRequested.store(autoTrim.load() && finalLength > 0);
     currentState.store(LooperState::Stopped);
     
     // Notify host that record button is off
@@ -326,6 +636,50 @@ void LooperEngine::stopRecording()
         parameterNotifyCallback(ParameterIDs::record, 0.0f);
 }
 
+void LooperEngine::fillBuffer()
+{
+    // Out of loop memory: the take so far becomes the loop and plays straight on, with
+    // every LED lit, until Record (new take) or Play (keep this one) is pressed
+    stopRecording();
+    startPlayback();
+
+    if (currentState.load() == LooperState::Playing)
+        currentState.store(LooperState::BufferFilled);
+}
+
+void LooperEngine::startPlaybackAfterRecording()
+{
+    // Recorded in reverse with Direction still on: keep re-recording while playing it back
+    if (recordDirection.load() == LoopMode::Reverse && loopMode.load() == LoopMode::Reverse)
+        startContinuousReverse();
+    else
+        startPlayback();
+}
+
+void LooperEngine::startContinuousReverse()
+{
+    auto& activeSlot = loopSlots[static_cast<size_t>(activeLoopSlot.load())];
+
+    if (!activeSlot.hasContent.load())
+        return;
+
+    // The take's last sample is at the loop start, so sweeping up from there plays it
+    // backwards; each sweep then plays the previous one's input backwards again
+    activeSlot.isRecording.store(true);
+    activeSlot.isPlaying.store(true);
+    activeSlot.fadeOutGain.store(0.0f);
+    activeSlot.trimRequested.store(false);  // Its audio is rewritten every pass
+    activeSlot.playPosition.store(0.0);
+    continuousReverseStep.store(1);
+    currentState.store(LooperState::ContinuousReverse);
+
+    if (parameterNotifyCallback)
+    {
+        parameterNotifyCallback(ParameterIDs::record, 1.0f);
+        parameterNotifyCallback(ParameterIDs::play, 1.0f);
+    }
+}
+
 void LooperEngine::startPlayback()
 {
     auto& activeSlot = loopSlots[static_cast<size_t>(activeLoopSlot.load())];
@@ -333,9 +687,10 @@ void LooperEngine::startPlayback()
     if (activeSlot.hasContent.load())
     {
         activeSlot.isPlaying.store(true);
+        activeSlot.fadeOutGain.store(0.0f);
         activeSlot.playPosition.store((loopMode.load() == LoopMode::Reverse)
-            ? static_cast<float>(activeSlot.length.load() - 1)
-            : 0.0f);
+            ? static_cast<double>(activeSlot.length.load() - 1)
+            : 0.0);
         currentState.store(LooperState::Playing);
         
         // Notify host that play button is on
@@ -348,12 +703,22 @@ void LooperEngine::stopPlayback()
 {
     auto& activeSlot = loopSlots[static_cast<size_t>(activeLoopSlot.load())];
     
+    // Ends a continuous reverse pass too
+    const bool wasRecording = (currentState.load() == LooperState::ContinuousReverse);
+
+    activeSlot.isRecording.store(false);
     activeSlot.isPlaying.store(false);
+    activeSlot.fadeOutGain.store(0.0f);  // No punch-out tail once stopped
     currentState.store(LooperState::Stopped);
     
     // Notify host that play button is off
     if (parameterNotifyCallback)
+    {
         parameterNotifyCallback(ParameterIDs::play, 0.0f);
+
+        if (wasRecording)
+            parameterNotifyCallback(ParameterIDs::record, 0.0f);
+    }
 }
 
 void LooperEngine::startOverdubbing()
@@ -364,8 +729,12 @@ void LooperEngine::startOverdubbing()
     {
         activeSlot.isRecording.store(true);
         activeSlot.isPlaying.store(true);
-        currentState.store(LooperState::Overdubbing);
+        activeSlot.overdubMarkerStale.store(true);
+        activeSlot.fadeInGain.store(0.0f);   // Punch in
+        activeSlot.fadeOutGain.store(1.0f);
+        // Stack before state: the playback path already overdubs while the stack is on
         stackMode.store(StackMode::On);
+        currentState.store(LooperState::Overdubbing);
         
         // Notify host of stack mode on
         if (parameterNotifyCallback)
@@ -410,13 +779,14 @@ void LooperEngine::toggleDirection()
     loopMode.store(newLoop);
 
     auto& activeSlot = loopSlots[static_cast<size_t>(activeLoopSlot.load())];
+    activeSlot.direction.store(newLoop);
     // Ensure playhead stays within bounds after direction change
-    float currentPlayPos = activeSlot.playPosition.load();
+    double currentPlayPos = activeSlot.playPosition.load();
     int currentLength = activeSlot.length.load();
-    if (currentPlayPos < 0.0f && currentLength > 0)
-        activeSlot.playPosition.store(currentPlayPos + static_cast<float>(currentLength));
-    else if (currentPlayPos >= static_cast<float>(currentLength) && currentLength > 0)
-        activeSlot.playPosition.store(std::fmod(currentPlayPos, static_cast<float>(currentLength)));
+    if (currentPlayPos < 0.0 && currentLength > 0)
+        activeSlot.playPosition.store(currentPlayPos + static_cast<double>(currentLength));
+    else if (currentPlayPos >= static_cast<double>(currentLength) && currentLength > 0)
+        activeSlot.playPosition.store(std::fmod(currentPlayPos, static_cast<double>(currentLength)));
     
     // Notify host of state change
     if (parameterNotifyCallback)
@@ -459,6 +829,7 @@ void LooperEngine::toggleSpeedMode()
     auto current = speedMode.load();
     auto newMode = (current == SpeedMode::Normal) ? SpeedMode::Half : SpeedMode::Normal;
     speedMode.store(newMode);
+    loopSlots[static_cast<size_t>(activeLoopSlot.load())].speed.store(getSpeedMultiplier());
     
     // Notify host of speed mode change
     if (parameterNotifyCallback)
@@ -468,6 +839,7 @@ void LooperEngine::toggleSpeedMode()
 void LooperEngine::setSpeedMode(SpeedMode mode)
 {
     speedMode.store(mode);
+    loopSlots[static_cast<size_t>(activeLoopSlot.load())].speed.store(getSpeedMultiplier());
     
     // Notify host of speed mode change
     if (parameterNotifyCallback)
@@ -475,223 +847,2082 @@ void LooperEngine::setSpeedMode(SpeedMode mode)
 }
 
 //==============================================================================
-void LooperEngine::processRecording(juce::AudioBuffer<float>& buffer, LoopSlot& slot)
+template <typename SampleType>
+void LooperEngine::processArmed(juce::AudioBuffer<SampleType>& buffer, LoopSlot& slot)
 {
-    int numSamples = buffer.getNumSamples();
-    const int inputChannels = buffer.getNumChannels();
-    float speed = (speedMode.load() == SpeedMode::Half) ? 0.5f : 1.0f;
-    
-    for (int sample = 0; sample < numSamples; ++sample)
+    const int onset = findOnset(buffer);
+
+    // Until the onset the input passes through as when stopped
+    if (thruMute.load() == ThruMuteState::On)
+        buffer.clear(0, (onset < 0) ? buffer.getNumSamples() : onset);
+
+    if (onset < 0)
+        return;
+
+    // A button press may be cancelling the arm right now (issue #39): stay armed and look
+    // for the onset again next block rather than start under it
+    bool expected = false;
+    if (!stateTransitionInProgress.compare_exchange_strong(expected, true))
+        return;
+
+    if (currentState.load() != LooperState::Armed)
     {
-        float currentRecordPos = slot.recordPosition.load();
-        int writePos = static_cast<int>(currentRecordPos);
-        
-        // Check bounds BEFORE writing
-        if (writePos < 0 || writePos >= maxLoopSamples)
-        {
-            // Buffer filled or invalid position - stop recording
-            stopRecording();
-            return;  // Exit immediately, don't process remaining samples
-        }
+        stateTransitionInProgress.store(false);
+        return;
+    }
+
+    // Record from the onset sample itself, so the loop starts on the attack
+    startRecording();
+    stateTransitionInProgress.store(false);
+
+    juce::AudioBuffer<SampleType> fromOnset(buffer.getArrayOfWritePointers(), buffer.getNumChannels(),
+                                            onset, buffer.getNumSamples() - onset);
+    processRecording(fromOnset, slot);
+}
+
+template <typename SampleType>
+int LooperEngine::findOnset(const juce::AudioBuffer<SampleType>& buffer) const
+{
+    // Vectorised min/max over short runs finds the run holding the onset; only that run
+    // is scanned sample by sample. Later channels only need to look before the earliest
+    // onset found so far.
+    constexpr int scanLength = 64;
+    const auto threshold = static_cast<SampleType>(triggerThreshold);
+    const int channels = juce::jmin(numChannels, buffer.getNumChannels());
+    int onset = buffer.getNumSamples();
+
+    for (int channel = 0; channel < channels; ++channel)
+    {
+        const SampleType* in = buffer.getReadPointer(channel);
 
-        for (int channel = 0; channel < numChannels; ++channel)
+        for (int start = 0; start < onset; start += scanLength)
         {
-            // If we only have a mono input, mirror it across all loop channels
-            const int sourceChannel = (inputChannels > 0) ? juce::jmin(channel, inputChannels - 1) : 0;
-            const float inputSample = (inputChannels > 0) ? buffer.getSample(sourceChannel, sample) : 0.0f;
-            slot.buffer.setSample(channel, writePos, inputSample);
+            const int runLength = juce::jmin(scanLength, onset - start);
+            const auto range = juce::FloatVectorOperations::findMinAndMax(in + start, runLength);
+
+            if (range.getEnd() <= threshold && range.getStart() >= -threshold)
+                continue;
+
+            for (int i = 0; i < runLength; ++i)
+            {
+                if (std::abs(in[start + i]) > threshold)
+                {
+                    onset = start + i;
+                    break;
+                }
+            }
+
+            break;
         }
-        
-        // Advance record position respecting direction
-        if (loopMode.load() == LoopMode::Reverse)
-            slot.recordPosition.store(currentRecordPos - speed);
-        else
-            slot.recordPosition.store(currentRecordPos + speed);
     }
-    
-    // When thru mute is on, mute the input passthrough while recording
-    if (thruMute.load() == ThruMuteState::On)
-        buffer.clear();
+
+    return (onset < buffer.getNumSamples()) ? onset : -1;
 }
 
-void LooperEngine::processPlayback(juce::AudioBuffer<float>& buffer, LoopSlot& slot)
+template <typename SampleType>
+void LooperEngine::processRecording(juce::AudioBuffer<SampleType>& buffer, LoopSlot& slot)
 {
-    if (!slot.hasContent.load() || slot.length.load() == 0)
-    {
-        buffer.clear();
+    // A slot still holding a capture's ring-sized buffer takes a full one back first. If the
+    // worker is reading it right now, the take starts a chunk later.
+    if (!reclaimSlotBuffer(slot))
         return;
-    }
 
-    // If stack mode is active, handle the whole buffer in the overdub path to
-    // avoid re-processing the buffer per channel/sample.
-    if (stackMode.load() == StackMode::On)
-    {
-        processOverdubbing(buffer, slot);
-        return;
-    }
+    const int numSamples = buffer.getNumSamples();
+    // Loop storage is sized to the input layout, so loop channel N records input channel N
+    const int channels = juce::jmin(numChannels, buffer.getNumChannels(), slot.buffer.getNumChannels());
+    const float speed = getSpeedMultiplier();
+    const bool reverse = (recordDirection.load() == LoopMode::Reverse);
+    double currentRecordPos = slot.recordPosition.load();
+    const int firstPos = static_cast<int>(currentRecordPos);
+    int samplesToRecord = numSamples;
 
-    int numSamples = buffer.getNumSamples();
-    float speed = (speedMode.load() == SpeedMode::Half) ? 0.5f : 1.0f;
-    auto loopDirection = loopMode.load();
-    auto thruMuteState = thruMute.load();
-    auto once = onceMode.load();
-    int slotLength = slot.length.load();
-    float volume = outputVolume.load();  // Apply volume to loop signal only (issue #44)
-    
-    for (int sampleNum = 0; sampleNum < numSamples; ++sampleNum)
+    if (speed == 1.0f)
     {
-        float currentPlayPos = slot.playPosition.load();
-        for (int channel = 0; channel < numChannels; ++channel)
+        // Unity speed writes one contiguous span (descending in reverse)
+        const int startPos = static_cast<int>(currentRecordPos);
+        const int available = reverse ? startPos + 1 : maxLoopSamples - startPos;
+        samplesToRecord = juce::jlimit(0, numSamples, available);
+
+        for (int channel = 0; channel < channels; ++channel)
         {
-            int pos = static_cast<int>(currentPlayPos);
-            float frac = currentPlayPos - pos;
-            
-            float loopSample;
-            
-            if (loopDirection == LoopMode::Reverse)
+            const SampleType* in = buffer.getReadPointer(channel);
+            StorageType* loop = slot.buffer.getWritePointer(channel);
+
+            if (reverse)
             {
-                // Read directly at the decreasing playhead position
-                int prevPos = (pos > 0) ? pos - 1 : (slotLength - 1);
-                float sample1 = slot.buffer.getSample(channel, pos);
-                float sample2 = slot.buffer.getSample(channel, prevPos);
-                loopSample = sample1 + frac * (sample2 - sample1);
+                for (int i = 0; i < samplesToRecord; ++i)
+                    loop[startPos - i] = static_cast<StorageType>(in[i]);
             }
             else
             {
-                int nextPos = (pos + 1) % slotLength;
-                float sample1 = slot.buffer.getSample(channel, pos);
-                float sample2 = slot.buffer.getSample(channel, nextPos);
-                loopSample = sample1 + frac * (sample2 - sample1);
+                copySamples(loop + startPos, in, samplesToRecord);
             }
-            
-            // Apply volume to loop signal only, not input (issue #44)
-            float scaledLoopSample = loopSample * volume;
-            
-            // Thru mute handling: when ON, only play loop; when OFF, mix input with loop
-            if (thruMuteState == ThruMuteState::On)
+        }
+
+        currentRecordPos += static_cast<double>(reverse ? -samplesToRecord : samplesToRecord);
+    }
+    else
+    {
+        // Half speed: every input pair becomes one loop sample. The decimator band-limits
+        // first, then each channel's output is written as one contiguous span.
+        if (recordDecimatorNeedsReset.exchange(false))
+            recordDecimator.reset();
+
+        const int startPos = static_cast<int>(currentRecordPos);
+        const int available = reverse ? startPos + 1 : maxLoopSamples - startPos;
+        int samplesToWrite = 0;
+
+        for (int channel = 0; channel < channels; ++channel)
+        {
+            const int numDecimated = recordDecimator.process(channel, buffer.getReadPointer(channel), numSamples, decimatedInput.get());
+            samplesToWrite = juce::jlimit(0, numDecimated, available);
+            StorageType* loop = slot.buffer.getWritePointer(channel);
+
+            if (reverse)
             {
-                buffer.setSample(channel, sampleNum, scaledLoopSample);
+                for (int i = 0; i < samplesToWrite; ++i)
+                    loop[startPos - i] = decimatedInput[i];
             }
             else
             {
-                float inputSample = buffer.getSample(channel, sampleNum);
-                buffer.setSample(channel, sampleNum, scaledLoopSample + inputSample);
+                copySamples(loop + startPos, decimatedInput.get(), samplesToWrite);
             }
+
+            if (samplesToWrite < numDecimated)
+                samplesToRecord = 2 * samplesToWrite;  // Ran out of loop storage
         }
-        
-        bool wrapped = advancePosition(slot.playPosition, slotLength, speed);
-        
-        if (wrapped)
-            loopWrapped.store(true);
-        
-        // Once mode: request stop via flag instead of direct state write (issue #38)
-        if (once == OnceMode::On && wrapped)
-        {
-            stopPlayback();
-            shouldDisableOnce.store(true);  // UI timer will call toggleOnceMode()
-            break;
-        }
+
+        recordDecimator.advance(numSamples);
+        currentRecordPos += static_cast<double>(reverse ? -samplesToWrite : samplesToWrite);
+    }
+
+    slot.recordPosition.store(currentRecordPos);
+
+    // The take so far is valid; whatever an earlier take left beyond it draws as silence
+    const int endPos = static_cast<int>(currentRecordPos);
+    if (reverse)
+        updateOverview(slot, getBufferView(slot), endPos + 1, firstPos + 1, endPos + 1, maxLoopSamples);
+    else
+        updateOverview(slot, getBufferView(slot), firstPos, endPos, 0, endPos);
+
+    // When thru mute is on, mute the input passthrough while recording
+    if (thruMute.load() == ThruMuteState::On)
+        buffer.clear(0, samplesToRecord);
+
+    // Buffer filled: the loop starts playing on the very next sample
+    if (samplesToRecord < numSamples)
+    {
+        fillBuffer();
+        processPlaybackFrom(buffer, slot, samplesToRecord);
     }
 }
 
-void LooperEngine::processOverdubbing(juce::AudioBuffer<float>& buffer, LoopSlot& slot)
+template <typename SampleType>
+void LooperEngine::processPlayback(juce::AudioBuffer<SampleType>& buffer, LoopSlot& slot)
 {
     if (!slot.hasContent.load() || slot.length.load() == 0)
     {
-        processRecording(buffer, slot);
+        buffer.clear();
         return;
     }
 
-    int numSamples = buffer.getNumSamples();
-    const int inputChannels = buffer.getNumChannels();
-    float speed = (speedMode.load() == SpeedMode::Half) ? 0.5f : 1.0f;
-    auto thruMuteState = thruMute.load();
-    auto once = onceMode.load();
-    int slotLength = slot.length.load();
-    float volume = outputVolume.load();  // Apply volume to loop output only (issue #44)
-    
-    for (int sample = 0; sample < numSamples; ++sample)
+    // If stack mode is active, handle the whole buffer in the overdub path to
+    // avoid re-processing the buffer per channel/sample. The overdub path also runs
+    // the short punch-out fade after the stack is released.
+    if (stackMode.load() == StackMode::On || slot.fadeOutGain.load() > 0.0f)
     {
-        float currentPlayPos = slot.playPosition.load();
-        int pos = static_cast<int>(currentPlayPos);
-        
-        for (int channel = 0; channel < numChannels; ++channel)
-        {
-            // Mirror mono input across all loop channels when needed
-            const int sourceChannel = (inputChannels > 0) ? juce::jmin(channel, inputChannels - 1) : 0;
-            float inputSample = (inputChannels > 0) ? buffer.getSample(sourceChannel, sample) : 0.0f;
-            float loopSample = slot.buffer.getSample(channel, pos);
-            
-            // Overdub: mix input with existing content
-            // Attenuate existing loop by 2.5dB to prevent overloading when stacking
-            constexpr float stackAttenuation = 0.74989420933f; // -2.5dB
-            float attenuatedLoop = loopSample * stackAttenuation;
-            float overdubSample = attenuatedLoop + (inputSample * feedbackAmount.load());
-            slot.buffer.setSample(channel, pos, overdubSample);
-            
-            // Apply volume to loop output only, not input (issue #44)
-            float scaledLoopOutput = overdubSample * volume;
-            
-            // Thru mute handling: when ON, only output loop; when OFF, mix with input
-            if (thruMuteState == ThruMuteState::On)
-            {
-                buffer.setSample(channel, sample, scaledLoopOutput);
-            }
-            else
-            {
-                buffer.setSample(channel, sample, scaledLoopOutput + inputSample);
-            }
-        }
-        
-        bool wrapped = advancePosition(slot.playPosition, slotLength, speed);
+        processOverdubbing(buffer, slot);
+        return;
+    }
 
-        if (wrapped)
-            loopWrapped.store(true);
+    const int numSamples = buffer.getNumSamples();
+    // Apply volume to loop signal only (issue #44), ramped from the last block's gain
+    const float gain = outputVolume.load() * slot.gain.load();
+    const float startGain = advanceRamp(slot.appliedGain, gain);
+
+    // A routed slot is read straight into its own output; otherwise via scratch into the main mix
+    auto& scratch = getBlockBuffers<SampleType>().scratch;
+    auto* routedOutput = getRoutedOutput<SampleType>(slot);
+    const int wrapOffset = readSlot(slot, (routedOutput != nullptr) ? *routedOutput : scratch,
+                                    numSamples, loopMode.load(), getPlaybackRate(slot, getSpeedMultiplier()));
+    int loopSamples = numSamples;
+
+    if (wrapOffset >= 0)
+    {
+        loopWrapped.store(true);
 
         // Once mode: request stop via flag instead of direct state write (issue #38)
-        if (once == OnceMode::On && wrapped)
+        if (onceMode.load() == OnceMode::On)
         {
+            loopSamples = wrapOffset;
             stopPlayback();
             shouldDisableOnce.store(true);  // UI timer will call toggleOnceMode()
-            break;
         }
     }
-}
 
-bool LooperEngine::advancePosition(std::atomic<float>& position, int length, float speed)
-{
-    bool wrapped = false;
-    auto loopDirection = loopMode.load();
-    float currentPos = position.load();
+    // Thru mute handling: when ON, only play loop; when OFF, mix input with loop
+    if (thruMute.load() == ThruMuteState::On)
+        buffer.clear();
 
-    if (loopDirection == LoopMode::Reverse)
+    if (routedOutput != nullptr)
+        finishRoutedOutput<SampleType>(slot, loopSamples, startGain, gain);
+    else
+        mixSlot(buffer, scratch, loopSamples, startGain, gain);
+}
+
+template <typename SampleType>
+void LooperEngine::processPlaybackFrom(juce::AudioBuffer<SampleType>& buffer, LoopSlot& slot, int startSample)
+{
+    // The rest of a chunk that changed state part-way through. A routed slot's output is
+    // narrowed to match, after silencing the part it had nothing for.
+    if (auto* routedOutput = getRoutedOutput<SampleType>(slot))
+    {
+        juce::AudioBuffer<SampleType> whole (routedOutput->getArrayOfWritePointers(), routedOutput->getNumChannels(), routedOutput->getNumSamples());
+        routedOutput->clear(0, startSample);
+        routedOutput->setDataToReferTo(whole.getArrayOfWritePointers(), whole.getNumChannels(), startSample, whole.getNumSamples() - startSample);
+    }
+
+    juce::AudioBuffer<SampleType> rest (buffer.getArrayOfWritePointers(), buffer.getNumChannels(), startSample, buffer.getNumSamples() - startSample);
+    processPlayback(rest, slot);
+}
+
+template <typename SampleType>
+void LooperEngine::processContinuousReverse(juce::AudioBuffer<SampleType>& buffer, LoopSlot& slot)
+{
+    const int numSamples = buffer.getNumSamples();
+    const int slotLength = slot.length.load();
+    const int channels = juce::jmin(numChannels, buffer.getNumChannels(), slot.buffer.getNumChannels());
+
+    if (slotLength == 0)
+    {
+        buffer.clear();
+        return;
+    }
+
+    const float gain = outputVolume.load() * slot.gain.load();
+    const float startGain = advanceRamp(slot.appliedGain, gain);
+
+    auto& scratch = getBlockBuffers<SampleType>().scratch;
+    auto* routedOutput = getRoutedOutput<SampleType>(slot);
+    auto& output = (routedOutput != nullptr) ? *routedOutput : scratch;
+
+    const int startPosition = juce::jlimit(0, slotLength - 1, static_cast<int>(slot.playPosition.load()));
+    const int startStep = continuousReverseStep.load();
+    int position = startPosition;
+    int step = startStep;
+    bool turned = false;
+
+    // One head reads each sample out and writes the input in its place, so what it plays is
+    // always the previous sweep's input - backwards, since the sweeps alternate direction.
+    // Every channel walks the same path, in runs that end where the head turns.
+    for (int channel = 0; channel < channels; ++channel)
+    {
+        const SampleType* in = buffer.getReadPointer(channel);
+        SampleType* out = output.getWritePointer(channel);
+        StorageType* loop = getLoopData(slot, channel);
+        position = startPosition;
+        step = startStep;
+        int done = 0;
+
+        while (done < numSamples)
+        {
+            const int run = juce::jmin(numSamples - done, (step > 0) ? slotLength - position : position + 1);
+
+            for (int i = 0; i < run; ++i, position += step)
+            {
+                out[done + i] = static_cast<SampleType>(loop[position]);
+                loop[position] = static_cast<StorageType>(in[done + i]);
+            }
+
+            done += run;
+
+            if (position == slotLength || position < 0)
+            {
+                step = -step;
+                position += step;
+                turned = true;
+            }
+        }
+    }
+
+    slot.playPosition.store(static_cast<double>(position));
+    continuousReverseStep.store(step);
+    ++slot.takeRevision;
+
+    // The span the head swept, out to the end it turned at
+    int sweptFrom = juce::jmin(startPosition, position);
+    int sweptTo = juce::jmax(startPosition, position) + 1;
+
+    if (numSamples >= slotLength)
+    {
+        sweptFrom = 0;
+        sweptTo = slotLength;
+    }
+    else if (turned)
+    {
+        if (step < 0)
+            sweptTo = slotLength;  // Turned at the top
+        else
+            sweptFrom = 0;
+    }
+
+    updateLoopOverview(slot, sweptFrom, juce::jmin(sweptTo, slotLength) - sweptFrom);
+
+    if (turned)
+        loopWrapped.store(true);
+
+    // Only the reversed signal when thru mute is on
+    if (thruMute.load() == ThruMuteState::On)
+        buffer.clear();
+
+    if (routedOutput != nullptr)
+        finishRoutedOutput<SampleType>(slot, numSamples, startGain, gain);
+    else
+        mixSlot(buffer, scratch, numSamples, startGain, gain);
+}
+
+template <typename SampleType>
+void LooperEngine::processMultiTrackPlayback(juce::AudioBuffer<SampleType>& buffer)
+{
+    const int numSamples = buffer.getNumSamples();
+    const int activeIndex = activeLoopSlot.load();
+    const float volume = outputVolume.load();
+    auto& scratch = getBlockBuffers<SampleType>().scratch;
+
+    // The active slot has already been handled by the state's own kernel; each other
+    // track is read with its own playhead/direction/speed and summed in one vector pass.
+    for (int slotIndex = 0; slotIndex < maxLoopSlots; ++slotIndex)
+    {
+        if (slotIndex == activeIndex)
+            continue;
+
+        auto& slot = loopSlots[static_cast<size_t>(slotIndex)];
+        if (!slot.hasContent.load() || slot.length.load() == 0)
+            continue;
+
+        const float gain = volume * slot.gain.load();
+        const float startGain = advanceRamp(slot.appliedGain, gain);
+
+        if (auto* routedOutput = getRoutedOutput<SampleType>(slot))
+        {
+            readSlot(slot, *routedOutput, numSamples, slot.direction.load(), getPlaybackRate(slot, slot.speed.load()));
+            finishRoutedOutput<SampleType>(slot, numSamples, startGain, gain);
+        }
+        else
+        {
+            readSlot(slot, scratch, numSamples, slot.direction.load(), getPlaybackRate(slot, slot.speed.load()));
+            mixSlot(buffer, scratch, numSamples, startGain, gain);
+        }
+    }
+}
+
+template <typename SampleType>
+int LooperEngine::readSlot(LoopSlot& slot, juce::AudioBuffer<SampleType>& dest, int numSamples, LoopMode direction, double rate)
+{
+    const int slotLength = slot.length.load();
+    const int channels = juce::jmin(dest.getNumChannels(), slot.buffer.getNumChannels());
+    const bool reverse = (direction == LoopMode::Reverse);
+    int wrapOffset = -1;
+
+    // A multiplied loop reads its virtual repeats through the page map
+    const auto& pages = slot.pages;
+    const bool paged = !pages.isIdentity();
+    const int loopOffset = slot.loopStart.load() - slot.takeStart.load();
+
+    double currentPlayPos = slot.playPosition.load();
+    if (currentPlayPos < 0.0 || currentPlayPos >= static_cast<double>(slotLength))
+        currentPlayPos = reverse ? static_cast<double>(slotLength - 1) : 0.0;
+
+    const double startPosition = currentPlayPos;
+
+    if (rate == 1.0 && currentPlayPos == std::floor(currentPlayPos))
     {
-        currentPos -= speed;
-        // Wrap to end when going below 0
-        if (currentPos < 0)
+        // Unity rate on a whole-sample playhead: plain span copies, split only at the loop seam
+        int pos = static_cast<int>(currentPlayPos);
+        int done = 0;
+
+        while (done < numSamples)
         {
-            currentPos += length;
-            wrapped = true;
+            int span = reverse ? juce::jmin(numSamples - done, pos + 1)
+                               : juce::jmin(numSamples - done, slotLength - pos);
+            int sourcePos = pos;
+
+            if (paged)
+            {
+                span = juce::jmin(span, pages.getRunLength(loopOffset + pos, reverse ? -1 : 1));
+                sourcePos = pages.resolve(loopOffset + pos) - loopOffset;
+            }
+
+            for (int channel = 0; channel < channels; ++channel)
+            {
+                const StorageType* source = getLoopData(slot, channel);
+                SampleType* out = dest.getWritePointer(channel, done);
+
+                if (reverse)
+                {
+                    for (int i = 0; i < span; ++i)
+                        out[i] = static_cast<SampleType>(source[sourcePos - i]);
+                }
+                else
+                {
+                    copySamples(out, source + sourcePos, span);
+                }
+            }
+
+            done += span;
+            pos += reverse ? -span : span;
+
+            if (pos < 0 || pos >= slotLength)
+            {
+                pos = reverse ? slotLength - 1 : 0;
+                if (wrapOffset < 0)
+                    wrapOffset = done;
+            }
+        }
+
+        applySeamFade(slot, dest, channels, numSamples, startPosition, reverse ? -1.0 : 1.0);
+        slot.playPosition.store(static_cast<double>(pos));
+        slot.crossedSeam = slot.crossedSeam || wrapOffset >= 0;
+        return wrapOffset;
+    }
+
+    if (timeStretch.load())
+    {
+        // Keep pitch: the playhead moves at the rate as usual, but the phase vocoder renders
+        // it at the loop's original pitch rather than resampling
+        const juce::AudioProcessLoadMeasurer::ScopedTimer timer(timeStretchLoad, numSamples);
+        const double step = reverse ? -rate : rate;
+        const juce::AudioBuffer<StorageType> loop(slot.buffer.getArrayOfWritePointers(), channels, slot.loopStart.load(), slotLength);
+
+        timeStretchers[static_cast<size_t>(getSlotIndex(slot))]
+            .process(loop, slotLength, currentPlayPos, step, dest, channels, numSamples, paged ? &pages : nullptr, loopOffset);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            currentPlayPos += step;
+
+            if (currentPlayPos >= static_cast<double>(slotLength) || currentPlayPos < 0.0)
+            {
+                currentPlayPos = snapToWholeSampleAtUnity(currentPlayPos - std::copysign(static_cast<double>(slotLength), step),
+                                                          rate, slotLength);
+                if (wrapOffset < 0)
+                    wrapOffset = i + 1;
+            }
+        }
+
+        applySeamFade(slot, dest, channels, numSamples, startPosition, step);
+        slot.playPosition.store(currentPlayPos);
+        slot.crossedSeam = slot.crossedSeam || wrapOffset >= 0;
+        return wrapOffset;
+    }
+
+    // Variable rate (varispeed, half speed, tempo stretch) or fractional playhead. Walk the
+    // positions once, storing each output sample's first tap and its windowed-sinc weights
+    // (band picked for the rate so faster playback doesn't alias); every channel then runs
+    // the same 16-tap dot products, so the per-channel cost is fixed whatever the rate.
+    const double step = reverse ? -rate : rate;
+    const float* band = sincTable.getBand(rate);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const int pos = static_cast<int>(currentPlayPos);
+        const int first = pos - SincTable::tapsBeforePosition;
+        blockIndex[i] = first;
+        SincTable::computeWeights(band, static_cast<float>(currentPlayPos - pos), blockWeights + i * SincTable::numTaps);
+
+        // Where the taps can be read as one contiguous run, or -1 for the wrapping path
+        if (first < 0 || first + SincTable::numTaps > slotLength)
+            blockSource[i] = -1;
+        else if (! paged)
+            blockSource[i] = first;
+        else
+            blockSource[i] = (pages.getRunLength(loopOffset + first, 1) >= SincTable::numTaps)
+                                 ? pages.resolve(loopOffset + first) - loopOffset : -1;
+
+        currentPlayPos += step;
+
+        if (currentPlayPos >= static_cast<double>(slotLength))
+        {
+            currentPlayPos = snapToWholeSampleAtUnity(currentPlayPos - static_cast<double>(slotLength), rate, slotLength);
+            if (wrapOffset < 0)
+                wrapOffset = i + 1;
+        }
+        else if (currentPlayPos < 0.0)
+        {
+            currentPlayPos = snapToWholeSampleAtUnity(currentPlayPos + static_cast<double>(slotLength), rate, slotLength);
+            if (wrapOffset < 0)
+                wrapOffset = i + 1;
+        }
+    }
+
+    constexpr int lanes = 4;
+    static_assert(SincTable::numTaps % lanes == 0, "Taps must split evenly across the accumulator lanes");
+
+    for (int channel = 0; channel < channels; ++channel)
+    {
+        const StorageType* source = getLoopData(slot, channel);
+        SampleType* out = dest.getWritePointer(channel);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float* weights = blockWeights + i * SincTable::numTaps;
+            const int first = blockIndex[i];
+            StorageType sum[lanes] = {};
+
+            if (blockSource[i] >= 0)
+            {
+                // Contiguous taps: independent lanes so the compiler can vectorize without reassociating
+                const StorageType* taps = source + blockSource[i];
+
+                for (int tap = 0; tap < SincTable::numTaps; tap += lanes)
+                    for (int lane = 0; lane < lanes; ++lane)
+                        sum[lane] += weights[tap + lane] * taps[tap + lane];
+            }
+            else
+            {
+                // Near the loop seam the taps wrap around (or repeat, for very short loops),
+                // and on a multiplied loop they may cross into another page
+                for (int tap = 0; tap < SincTable::numTaps; ++tap)
+                {
+                    int index = (first + tap) % slotLength;
+                    if (index < 0)
+                        index += slotLength;
+
+                    if (paged)
+                        index = pages.resolve(loopOffset + index) - loopOffset;
+
+                    sum[tap % lanes] += weights[tap] * source[index];
+                }
+            }
+
+            out[i] = static_cast<SampleType>((sum[0] + sum[1]) + (sum[2] + sum[3]));
+        }
+    }
+
+    applySeamFade(slot, dest, channels, numSamples, startPosition, step);
+    slot.playPosition.store(currentPlayPos);
+    slot.crossedSeam = slot.crossedSeam || wrapOffset >= 0;
+    return wrapOffset;
+}
+
+template <typename SampleType>
+void LooperEngine::mixSlot(juce::AudioBuffer<SampleType>& output, const juce::AudioBuffer<SampleType>& source, int numSamples,
+                           float startGain, float endGain)
+{
+    const int channels = juce::jmin(output.getNumChannels(), source.getNumChannels());
+    SlotMeter<SampleType> meter;
+
+    for (int channel = 0; channel < channels; ++channel)
+        scaleSlotChannel<true>(output.getWritePointer(channel), source.getReadPointer(channel), numSamples, startGain, endGain, meter);
+
+    addToLoopMeter(meter, channels * numSamples);
+}
+
+template <bool mixInto, typename SampleType>
+void LooperEngine::scaleSlotChannel(SampleType* out, const SampleType* in, int numSamples, float startGain, float endGain,
+                                    SlotMeter<SampleType>& meter) noexcept
+{
+    // Constant once the gain has settled; otherwise ramped linearly across the block
+    const auto start = static_cast<SampleType>(startGain);
+    const auto gainStep = (startGain == endGain) ? SampleType()
+                                                 : static_cast<SampleType>(endGain - startGain) / static_cast<SampleType>(juce::jmax(1, numSamples));
+    int i = 0;
+
+    // The loop meter takes each scaled sample on its way out. Independent lanes so the
+    // compiler can vectorize without reassociating.
+    for (; i + meterLanes <= numSamples; i += meterLanes)
+    {
+        for (int lane = 0; lane < meterLanes; ++lane)
+        {
+            const SampleType scaled = in[i + lane] * (start + gainStep * static_cast<SampleType>(i + lane));
+            out[i + lane] = mixInto ? out[i + lane] + scaled : scaled;
+            meter.peak[lane] = juce::jmax(meter.peak[lane], std::abs(scaled));
+            meter.sumOfSquares[lane] += scaled * scaled;
+        }
+    }
+
+    for (; i < numSamples; ++i)
+    {
+        const SampleType scaled = in[i] * (start + gainStep * static_cast<SampleType>(i));
+        out[i] = mixInto ? out[i] + scaled : scaled;
+        meter.peak[i % meterLanes] = juce::jmax(meter.peak[i % meterLanes], std::abs(scaled));
+        meter.sumOfSquares[i % meterLanes] += scaled * scaled;
+    }
+}
+
+template <typename SampleType>
+void LooperEngine::addToLoopMeter(const SlotMeter<SampleType>& meter, int numValues)
+{
+    SampleType peak = 0;
+    double sumOfSquares = 0.0;
+
+    for (int lane = 0; lane < meterLanes; ++lane)
+    {
+        peak = juce::jmax(peak, meter.peak[lane]);
+        sumOfSquares += static_cast<double>(meter.sumOfSquares[lane]);
+    }
+
+    loopMeter.add(static_cast<float>(peak), sumOfSquares, numValues);
+}
+
+//==============================================================================
+template <typename SampleType>
+void LooperEngine::bindSlotOutputs(SlotOutputs<SampleType>* slotOutputs, int startSample, int numSamples)
+{
+    auto& routedOutputs = getBlockBuffers<SampleType>().routedOutputs;
+
+    for (size_t i = 0; i < routedOutputs.size(); ++i)
+    {
+        routedOutputWritten[i] = false;
+        routedOutputActive[i] = (slotOutputs != nullptr && (*slotOutputs)[i].getNumChannels() > 0);
+
+        if (routedOutputActive[i])
+        {
+            auto& source = (*slotOutputs)[i];
+            routedOutputs[i].setDataToReferTo(source.getArrayOfWritePointers(), source.getNumChannels(), startSample, numSamples);
+        }
+    }
+}
+
+template <typename SampleType>
+void LooperEngine::clearUnwrittenSlotOutputs()
+{
+    auto& routedOutputs = getBlockBuffers<SampleType>().routedOutputs;
+
+    // Enabled outputs whose slot produced nothing this chunk must still be silenced;
+    // disabled outputs are skipped entirely
+    for (size_t i = 0; i < routedOutputs.size(); ++i)
+        if (routedOutputActive[i] && !routedOutputWritten[i])
+            routedOutputs[i].clear();
+}
+
+template <typename SampleType>
+juce::AudioBuffer<SampleType>* LooperEngine::getRoutedOutput(const LoopSlot& slot)
+{
+    const auto index = static_cast<size_t>(getSlotIndex(slot));
+    return routedOutputActive[index] ? &getBlockBuffers<SampleType>().routedOutputs[index] : nullptr;
+}
+
+template <typename SampleType>
+void LooperEngine::finishRoutedOutput(const LoopSlot& slot, int loopSamples, float startGain, float endGain)
+{
+    const auto index = static_cast<size_t>(getSlotIndex(slot));
+    auto& output = getBlockBuffers<SampleType>().routedOutputs[index];
+    const int numSamples = output.getNumSamples();
+    const int loopChannels = juce::jmin(output.getNumChannels(), slot.buffer.getNumChannels());
+
+    // readSlot() left raw loop audio in place - apply the gain there rather than copying
+    SlotMeter<SampleType> meter;
+
+    for (int channel = 0; channel < loopChannels; ++channel)
+    {
+        SampleType* out = output.getWritePointer(channel);
+        scaleSlotChannel<false>(out, out, loopSamples, startGain, endGain, meter);
+        juce::FloatVectorOperations::clear(out + loopSamples, numSamples - loopSamples);
+    }
+
+    addToLoopMeter(meter, loopChannels * loopSamples);
+    mirrorFirstChannel(output, loopChannels, numSamples);
+    routedOutputWritten[index] = true;
+}
+
+template <typename SampleType>
+void LooperEngine::mirrorFirstChannel(juce::AudioBuffer<SampleType>& output, int fromChannel, int numSamples)
+{
+    // A mono loop (mono input) feeding a wider output: mirror it like the main upmix does
+    if (fromChannel <= 0)
+    {
+        output.clear();
+        return;
+    }
+
+    for (int channel = fromChannel; channel < output.getNumChannels(); ++channel)
+        output.copyFrom(channel, 0, output, 0, 0, numSamples);
+}
+
+template <typename SampleType>
+void LooperEngine::processOverdubbing(juce::AudioBuffer<SampleType>& buffer, LoopSlot& slot)
+{
+    if (!slot.hasContent.load() || slot.length.load() == 0)
+    {
+        processRecording(buffer, slot);
+        return;
+    }
+
+    const int numSamples = buffer.getNumSamples();
+    const int channels = juce::jmin(numChannels, buffer.getNumChannels(), slot.buffer.getNumChannels());
+    const double rate = getPlaybackRate(slot, getSpeedMultiplier());
+    const bool reverse = (loopMode.load() == LoopMode::Reverse);
+    const bool thruMuted = (thruMute.load() == ThruMuteState::On);
+    const int slotLength = slot.length.load();
+    ++slot.takeRevision;  // Any trim scanned before this overdub is out of date
+    // Volume and feedback ramp from where the last block left them
+    const float feedback = feedbackAmount.load();
+    const float startFeedback = advanceRamp(appliedFeedback, feedback);
+    const float volume = outputVolume.load() * slot.gain.load();  // Apply volume to loop output only (issue #44)
+    const float startVolume = advanceRamp(slot.appliedGain, volume);
+    auto* routedOutput = getRoutedOutput<SampleType>(slot);
+    const int routedChannels = (routedOutput != nullptr) ? juce::jmin(routedOutput->getNumChannels(), channels) : 0;
+
+    // Attenuate the existing loop (2.5 dB by default) to prevent overloading when stacking,
+    // and darken it if a tone is set
+    decayFilter.setDecay(overdubDecay.load(), overdubTone.load());
+    const float stackAttenuation = static_cast<float>(decayFilter.getGain());
+
+    // Stack released: this is the punch-out tail
+    const bool punchingOut = (stackMode.load() == StackMode::Off);
+
+    // Walk the playhead once for the whole block; every channel reuses the integer
+    // positions and their fractional phase
+    const double startPlayPos = slot.playPosition.load();
+    double currentPlayPos = startPlayPos;
+    int samplesToProcess = numSamples;
+    float* fractions = blockWeights.get();
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const double wholePos = std::floor(currentPlayPos);
+        blockIndex[i] = static_cast<int>(wholePos);
+        fractions[i] = static_cast<float>(currentPlayPos - wholePos);
+
+        bool wrapped = false;
+        if (reverse)
+        {
+            currentPlayPos -= rate;
+            // Wrap to end when going below 0
+            if (currentPlayPos < 0.0)
+            {
+                currentPlayPos = snapToWholeSampleAtUnity(currentPlayPos + static_cast<double>(slotLength), rate, slotLength);
+                wrapped = true;
+            }
+        }
+        else
+        {
+            currentPlayPos += rate;
+            // Wrap to beginning when going past end, keeping the fractional phase (unless back at unity rate)
+            if (currentPlayPos >= static_cast<double>(slotLength))
+            {
+                currentPlayPos = snapToWholeSampleAtUnity(currentPlayPos - static_cast<double>(slotLength), rate, slotLength);
+                wrapped = true;
+            }
+        }
+
+        if (wrapped)
+        {
+            loopWrapped.store(true);
+
+            // Once mode: request stop via flag instead of direct state write (issue #38)
+            if (onceMode.load() == OnceMode::On)
+            {
+                samplesToProcess = i + 1;
+                stopPlayback();
+                shouldDisableOnce.store(true);  // UI timer will call toggleOnceMode()
+                break;
+            }
+        }
+    }
+
+    slot.playPosition.store(currentPlayPos);
+
+    // Punch fades: while ramping, each input sample gets its own gain. Once the punch-in
+    // has finished (and with no punch-out under way) the gains are all 1 and skipped.
+    float fadeIn = slot.fadeInGain.load();
+    float fadeOut = slot.fadeOutGain.load();
+    const float startPunchGain = fadeIn * fadeOut;
+    const bool punching = (fadeIn < 1.0f || punchingOut);
+    float* punchGains = blockWeights + samplesPerBlock;
+
+    if (punching)
+    {
+        const float fadeStep = 1.0f / static_cast<float>(fadeSamples);
+
+        for (int i = 0; i < samplesToProcess; ++i)
+        {
+            punchGains[i] = fadeIn * fadeOut;
+            fadeIn = juce::jmin(1.0f, fadeIn + fadeStep);
+
+            if (punchingOut)
+                fadeOut = juce::jmax(0.0f, fadeOut - fadeStep);
+        }
+
+        slot.fadeInGain.store(fadeIn);
+        slot.fadeOutGain.store(fadeOut);
+    }
+
+    const float endPunchGain = fadeIn * fadeOut;
+
+    // What's heard of the loop is faded at its seam like playback's (the writes aren't)
+    float* seamGains = blockWeights + 2 * samplesPerBlock;
+    const bool seamFading = getSeamGains(slot, startPlayPos, reverse ? -rate : rate, samplesToProcess, seamGains);
+
+    // Per-sample increments of the volume and feedback ramps (zero once automation settles)
+    const float rampLength = static_cast<float>(samplesToProcess);
+    const float volumeStep = (volume - startVolume) / rampLength;
+    const float feedbackStep = (feedback - startFeedback) / rampLength;
+
+    // Each input sample is split across the loop samples either side of the playhead, so
+    // forward writes reach floor(pos) + 1 and reverse writes reach down to floor(pos).
+    // The attenuation marker runs just ahead of those writes and attenuates every loop
+    // sample exactly once per pass, however many input samples land on it.
+    // Start a new pass when overdubbing (re)starts, changes direction or the playhead was moved
+    if (slot.overdubMarkerStale.exchange(false) || slot.overdubMarkerReverse != reverse
+        || slot.overdubMarkerPosition != startPlayPos)
+    {
+        const int startIndex = static_cast<int>(startPlayPos);
+        const bool onSample = (startPlayPos == static_cast<double>(startIndex));
+        slot.overdubMarker = (reverse && ! onSample) ? (startIndex + 1) % slotLength : startIndex;
+        slot.overdubMarkerReverse = reverse;
+        slot.limiterMarker = reverse ? (startIndex + 2) % slotLength : startIndex;
+        decayFilter.reset();
+    }
+
+    const int lastIndex = blockIndex[samplesToProcess - 1];
+    int attenuateFrom = 0;
+    int numToAttenuate = 0;
+
+    if (reverse)
+    {
+        const int nextMarker = (lastIndex - 1 + slotLength) % slotLength;
+        numToAttenuate = (slot.overdubMarker - nextMarker + slotLength) % slotLength;
+        attenuateFrom = (nextMarker + 1) % slotLength;
+        slot.overdubMarker = nextMarker;
+    }
+    else
+    {
+        const int nextMarker = (lastIndex + 2) % slotLength;
+        numToAttenuate = (nextMarker - slot.overdubMarker + slotLength) % slotLength;
+        attenuateFrom = slot.overdubMarker;
+        slot.overdubMarker = nextMarker;
+    }
+
+    slot.overdubMarkerPosition = currentPlayPos;
+
+    // A block longer than the loop crosses the marker more than once: the distance it moved
+    // is the span above plus a whole loop per extra lap, and every lap attenuates again.
+    // The playhead's travel tells the laps apart, to within the marker's lead of a sample or two.
+    const double travel = rate * static_cast<double>(samplesToProcess);
+    const int extraLaps = juce::jmax(0, static_cast<int>(std::lround((travel - numToAttenuate) / static_cast<double>(slotLength))));
+    const int numAttenuations = numToAttenuate + extraLaps * slotLength;
+
+    // Soft limiting trails the writes: future blocks write at floor(playhead) and the sample
+    // after it, so everything the playhead has left behind is final for this pass and is
+    // limited once, in contiguous spans. The marker runs whether or not the limiter is on, so
+    // switching it on mid-pass doesn't limit a backlog.
+    const bool limiting = softLimit.load();
+    const int endIndex = static_cast<int>(currentPlayPos);
+    int limitFrom = 0;
+    int numToLimit = 0;
+
+    if (reverse)
+    {
+        const int nextMarker = (endIndex + 2) % slotLength;
+        numToLimit = (slot.limiterMarker - nextMarker + slotLength) % slotLength;
+        limitFrom = nextMarker;
+        slot.limiterMarker = nextMarker;
+    }
+    else
+    {
+        numToLimit = (endIndex - slot.limiterMarker + slotLength) % slotLength;
+        limitFrom = slot.limiterMarker;
+        slot.limiterMarker = endIndex;
+    }
+
+    // After a lap, everything the block wrote is final: limit the whole loop, once
+    if (travel >= static_cast<double>(slotLength))
+    {
+        limitFrom = 0;
+        numToLimit = slotLength;
+    }
+
+    const int limitToEnd = juce::jmin(numToLimit, slotLength - limitFrom);
+
+    // Copy on write: the virtual pages of a multiplied loop that this block attenuates or
+    // writes become real first, so the kernel below can work on the loop in place
+    if (!slot.pages.isIdentity())
+    {
+        // Writes land either side of each position, so the block writes from its first
+        // position up to one past its last (down from one past the first in reverse)
+        const int firstIndex = blockIndex[0];
+        const bool wholeLoop = static_cast<double>(samplesToProcess) * rate + 2.0 >= static_cast<double>(slotLength);
+        const int writeFrom = wholeLoop ? 0 : (reverse ? lastIndex : firstIndex);
+        const int numToWrite = wholeLoop ? slotLength
+                                         : ((reverse ? firstIndex - lastIndex : lastIndex - firstIndex) + slotLength) % slotLength + 2;
+
+        materializeLoopRange(slot, attenuateFrom, juce::jmin(numAttenuations, slotLength));
+        materializeLoopRange(slot, writeFrom, numToWrite);
+    }
+
+    // The attenuated range can run across the loop seam, and round the loop again for each
+    // extra lap. The attenuation follows the punch gain, so it eases in at punch-in and back
+    // out to unity at punch-out.
+    const float startAttenuation = 1.0f - (1.0f - stackAttenuation) * startPunchGain;
+    const float endAttenuation = 1.0f - (1.0f - stackAttenuation) * endPunchGain;
+    const float attenuationStep = (numAttenuations > 0) ? (endAttenuation - startAttenuation) / static_cast<float>(numAttenuations) : 0.0f;
+
+    if (routedOutput != nullptr)
+    {
+        // Samples after a Once-mode stop stay silent
+        routedOutput->clear();
+        routedOutputWritten[static_cast<size_t>(getSlotIndex(slot))] = true;
+    }
+
+    // With a tone, the filter has to meet the samples in playhead order, all channels at once.
+    // Its mix is the punch gain, which has the same effect as the attenuation ramp below.
+    const bool filtering = decayFilter.isFiltering();
+
+    if (filtering && numAttenuations > 0)
+    {
+        static_assert(DecayFilter<StorageType>::lanes >= maxChannels, "Every loop channel needs a filter lane");
+        std::array<StorageType*, maxChannels> loopChannels {};
+        for (int channel = 0; channel < channels; ++channel)
+            loopChannels[static_cast<size_t>(channel)] = getLoopData(slot, channel);
+
+        const float mixStep = (endPunchGain - startPunchGain) / static_cast<float>(numAttenuations);
+
+        // One contiguous span per stretch between seams, in playhead order
+        for (int done = 0; done < numAttenuations;)
+        {
+            const float mix = startPunchGain + mixStep * static_cast<float>(done);
+
+            if (!reverse)
+            {
+                const int from = (attenuateFrom + done) % slotLength;
+                const int count = juce::jmin(numAttenuations - done, slotLength - from);
+                decayFilter.process(loopChannels.data(), channels, from, count, 1, mix, mixStep);
+                done += count;
+            }
+            else
+            {
+                const int from = (attenuateFrom + numAttenuations - 1 - done) % slotLength;
+                const int count = juce::jmin(numAttenuations - done, from + 1);
+                decayFilter.process(loopChannels.data(), channels, from, count, -1, mix, mixStep);
+                done += count;
+            }
+        }
+    }
+
+    // The loop meter rides along with the read-back below
+    SampleType loopPeak = 0;
+    SampleType loopSumOfSquares = 0;
+
+    for (int channel = 0; channel < channels; ++channel)
+    {
+        SampleType* io = buffer.getWritePointer(channel);
+        StorageType* loop = getLoopData(slot, channel);
+        SampleType* loopOut = (channel < routedChannels) ? routedOutput->getWritePointer(channel) : nullptr;
+
+        // Without a tone the decay is a plain gain; with one, the filter above has already run
+        if (!filtering)
+        {
+            for (int done = 0; done < numAttenuations;)
+            {
+                const int from = (attenuateFrom + done) % slotLength;
+                const int count = juce::jmin(numAttenuations - done, slotLength - from);
+
+                if (attenuationStep == 0.0f)
+                {
+                    for (int i = 0; i < count; ++i)
+                        loop[from + i] *= startAttenuation;
+                }
+                else
+                {
+                    for (int i = 0; i < count; ++i)
+                        loop[from + i] *= startAttenuation + attenuationStep * static_cast<float>(done + i);
+                }
+
+                done += count;
+            }
+        }
+
+        // Overdub: add the input to the loop, split by the playhead's fractional phase
+        for (int i = 0; i < samplesToProcess; ++i)
+        {
+            const int pos = blockIndex[i];
+            const int nextPos = (pos + 1 < slotLength) ? pos + 1 : 0;
+            const auto fraction = static_cast<StorageType>(fractions[i]);
+            const float feedbackGain = startFeedback + feedbackStep * static_cast<float>(i);
+            const auto input = static_cast<StorageType>(io[i] * (punching ? feedbackGain * punchGains[i] : feedbackGain));
+
+            loop[pos] += input * (StorageType(1) - fraction);
+            loop[nextPos] += input * fraction;
+        }
+
+        if (limiting)
+        {
+            SoftLimiter::process(loop + limitFrom, limitToEnd);
+            SoftLimiter::process(loop, numToLimit - limitToEnd);
+        }
+
+        for (int i = 0; i < samplesToProcess; ++i)
+        {
+            const int pos = blockIndex[i];
+            const int nextPos = (pos + 1 < slotLength) ? pos + 1 : 0;
+            const auto fraction = static_cast<StorageType>(fractions[i]);
+            const SampleType inputSample = io[i];
+
+            // Read the overdubbed loop back at the playhead
+            const StorageType overdubSample = loop[pos] * (StorageType(1) - fraction) + loop[nextPos] * fraction;
+
+            // Apply volume to loop output only, not input (issue #44)
+            const float outputGain = (startVolume + volumeStep * static_cast<float>(i)) * (seamFading ? seamGains[i] : 1.0f);
+            const auto scaledLoopOutput = static_cast<SampleType>(overdubSample * outputGain);
+            loopPeak = juce::jmax(loopPeak, std::abs(scaledLoopOutput));
+            loopSumOfSquares += scaledLoopOutput * scaledLoopOutput;
+
+            if (routedOutput != nullptr)
+            {
+                // Routed slot: the loop goes to its own output, the main output keeps only the input
+                if (loopOut != nullptr)
+                    loopOut[i] = scaledLoopOutput;
+
+                io[i] = thruMuted ? SampleType() : inputSample;
+            }
+            else
+            {
+                // Thru mute handling: when ON, only output loop; when OFF, mix with input
+                io[i] = thruMuted ? scaledLoopOutput : scaledLoopOutput + inputSample;
+            }
+        }
+    }
+
+    loopMeter.add(static_cast<float>(loopPeak), static_cast<double>(loopSumOfSquares), channels * samplesToProcess);
+
+    // Redraw what this block changed: the attenuated span, the samples either side of the
+    // playhead path and the span the limiter caught up on
+    const int firstIndex = blockIndex[0];
+    const bool sweptWholeLoop = (static_cast<double>(samplesToProcess) * rate >= static_cast<double>(slotLength - 1));
+    const int pathLength = ((reverse ? firstIndex - lastIndex : lastIndex - firstIndex) + slotLength) % slotLength;
+    const int writeSpan = sweptWholeLoop ? slotLength : juce::jmin(slotLength, pathLength + 2);
+
+    updateLoopOverview(slot, attenuateFrom, juce::jmin(numAttenuations, slotLength));
+    updateLoopOverview(slot, reverse ? lastIndex : firstIndex, writeSpan);
+
+    if (limiting)
+        updateLoopOverview(slot, limitFrom, numToLimit);
+
+    if (routedOutput != nullptr)
+        mirrorFirstChannel(*routedOutput, routedChannels, samplesToProcess);
+}
+
+template <typename DestType, typename SourceType>
+void LooperEngine::copySamples(DestType* dest, const SourceType* source, int numSamples)
+{
+    // Loop storage and the host buffer may differ in precision; convert only when they do
+    if constexpr (std::is_same_v<DestType, SourceType>)
+        juce::FloatVectorOperations::copy(dest, source, numSamples);
+    else
+        for (int i = 0; i < numSamples; ++i)
+            dest[i] = static_cast<DestType>(source[i]);
+}
+
+//==============================================================================
+double LooperEngine::getSyncUnitQuarterNotes() const
+{
+    // One beat is a 1/denominator note; a bar is numerator of them. Beats sync mode
+    // quantizes to beats, everything else (including transport follow) to bars.
+    const int numerator = juce::jmax(1, hostTransport.numerator);
+    const int denominator = juce::jmax(1, hostTransport.denominator);
+    const double quarterNotesPerBeat = 4.0 / static_cast<double>(denominator);
+
+    return (syncMode.load() == SyncMode::Beats) ? quarterNotesPerBeat : quarterNotesPerBeat * numerator;
+}
+
+void LooperEngine::followHostTransport()
+{
+    const bool hostPlaying = hostTransport.isPlaying;
+    const bool started = hostPlaying && !hostWasPlaying;
+    const bool stopped = !hostPlaying && hostWasPlaying;
+
+    if (!transportFollow.load() || (!started && !stopped))
+    {
+        hostWasPlaying = hostPlaying;
+        return;
+    }
+
+    // A button press holds the transition guard (issue #39): the host's start or stop is
+    // still unseen next block, and is followed then
+    bool expected = false;
+    if (!stateTransitionInProgress.compare_exchange_strong(expected, true))
+        return;
+
+    hostWasPlaying = hostPlaying;
+    const auto state = currentState.load();
+
+    if (started)
+    {
+        // Start on the first bar/beat boundary the host crosses (sample-exact, see processBlock)
+        if (state == LooperState::Stopped && loopSlots[static_cast<size_t>(activeLoopSlot.load())].hasContent.load())
+            pendingSyncAction.store(SyncAction::StartPlayback);
+
+        stateTransitionInProgress.store(false);
+        return;
+    }
+
+    // The host has stopped between blocks, so there is no boundary to wait for: stop now.
+    // An overdub is finished first so Stack is released rather than left on for the next start.
+    if (state == LooperState::Recording)
+    {
+        stopRecording();
+    }
+    else if (state == LooperState::Playing || state == LooperState::Overdubbing
+             || state == LooperState::ContinuousReverse || state == LooperState::BufferFilled)
+    {
+        if (state == LooperState::Overdubbing)
+            stopOverdubbing();
+
+        stopPlayback();
+    }
+
+    pendingSyncAction.store(SyncAction::None);
+    stateTransitionInProgress.store(false);
+}
+
+int LooperEngine::getSyncActionOffset(int startSample, int numSamples)
+{
+    const auto action = pendingSyncAction.load();
+
+    if (action == SyncAction::None)
+    {
+        syncActionPpq = -1.0;
+        return -1;
+    }
+
+    // Drop actions the state has moved past (e.g. a button already stopped the loop)
+    const bool recordingAction = (action == SyncAction::StopRecording || action == SyncAction::StopRecordingAndPlay);
+    const bool stillValid = isSyncActionValid(action);
+
+    // The host stopped (or Sync was switched off) while we were waiting: stops happen
+    // right here, a start is dropped
+    const bool available = recordingAction ? canSyncToHost() : hostSyncAvailable.load();
+
+    if (!stillValid || (!available && action == SyncAction::StartPlayback))
+    {
+        pendingSyncAction.store(SyncAction::None);
+        syncActionPpq = -1.0;
+        return -1;
+    }
+
+    if (!available)
+        return 0;
+
+    const double ppq = getHostPpqAt(startSample);
+
+    // The first time the audio thread sees the request, pick the next boundary at or after now
+    if (syncActionPpq < 0.0)
+    {
+        const double unit = getSyncUnitQuarterNotes();
+        syncActionPpq = std::ceil(ppq / unit - 1.0e-9) * unit;
+    }
+
+    // Samples until the boundary; a host that jumped past it acts immediately
+    const double samplesToAction = (syncActionPpq - ppq) * getSamplesPerQuarterNote();
+    const int offset = juce::jmax(0, static_cast<int>(std::ceil(samplesToAction - 1.0e-6)));
+
+    return (offset < numSamples) ? offset : -1;
+}
+
+bool LooperEngine::isSyncActionValid(SyncAction action) const
+{
+    const auto state = currentState.load();
+
+    switch (action)
+    {
+        case SyncAction::StopRecording:
+        case SyncAction::StopRecordingAndPlay:  return state == LooperState::Recording;
+        case SyncAction::StartPlayback:         return state == LooperState::Stopped;
+        case SyncAction::StopPlayback:          return state == LooperState::Playing || state == LooperState::Overdubbing;
+        case SyncAction::None:                  break;
+    }
+
+    return false;
+}
+
+bool LooperEngine::performSyncAction()
+{
+    // A button press may be changing the state right now (issue #39): leave the action
+    // pending, and it happens at the start of the next block instead
+    bool expected = false;
+    if (!stateTransitionInProgress.compare_exchange_strong(expected, true))
+        return false;
+
+    auto action = pendingSyncAction.exchange(SyncAction::None);
+
+    // The press that held the guard may have made the action moot
+    if (!isSyncActionValid(action))
+        action = SyncAction::None;
+
+    switch (action)
+    {
+        case SyncAction::StopRecording:
+        case SyncAction::StopRecordingAndPlay:
+            finishSyncedRecording(action);
+            break;
+
+        case SyncAction::StartPlayback:
+            // Multi-track: all tracks start together from their loop starts
+            if (playbackMode.load() == PlaybackMode::MultiTrack)
+                restartAllSlots();
+            startPlayback();
+            break;
+
+        case SyncAction::StopPlayback:
+            if (currentState.load() == LooperState::Overdubbing)
+                stopOverdubbing();
+            stopPlayback();
+            break;
+
+        case SyncAction::None:
+            break;
+    }
+
+    syncActionPpq = -1.0;
+    stateTransitionInProgress.store(false);
+    return true;
+}
+
+void LooperEngine::finishSyncedRecording(SyncAction action)
+{
+    auto& activeSlot = loopSlots[static_cast<size_t>(activeLoopSlot.load())];
+    const double stopPpq = syncActionPpq;
+    const bool synced = canSyncToHost() && stopPpq >= 0.0;
+
+    stopRecording();
+
+    if (synced)
+    {
+        // Snap the length to a whole number of bars/beats at the current tempo (at least one):
+        // a short take is extended with silence, a long one truncated
+        const double unit = getSyncUnitQuarterNotes();
+        const double samplesPerUnit = unit * getSamplesPerQuarterNote();
+        const int recordedLength = activeSlot.length.load();
+        const double maxUnits = std::floor(static_cast<double>(maxLoopSamples) / samplesPerUnit);
+        const double units = juce::jmin(maxUnits, juce::jmax(1.0, std::round(recordedLength / samplesPerUnit)));
+
+        if (units >= 1.0)
+        {
+            const int syncedLength = juce::jmin(maxLoopSamples, static_cast<int>(std::round(units * samplesPerUnit)));
+
+            // The take keeps its first syncedLength samples in time: above the start forwards,
+            // below the end in reverse, where the take was written downwards
+            if (recordDirection.load() == LoopMode::Reverse)
+            {
+                const int syncedStart = maxLoopSamples - syncedLength;
+
+                if (syncedLength > recordedLength)
+                    for (int channel = 0; channel < activeSlot.buffer.getNumChannels(); ++channel)
+                        activeSlot.buffer.clear(channel, syncedStart, syncedLength - recordedLength);
+
+                activeSlot.takeStart.store(syncedStart);
+                activeSlot.loopStart.store(syncedStart);
+            }
+            else if (syncedLength > recordedLength)
+            {
+                for (int channel = 0; channel < activeSlot.buffer.getNumChannels(); ++channel)
+                    activeSlot.buffer.clear(channel, recordedLength, syncedLength - recordedLength);
+            }
+
+            activeSlot.takeLength.store(syncedLength);
+            activeSlot.length.store(syncedLength);
+            activeSlot.hasContent.store(true);
+            activeSlot.overviewStale.store(true);  // The take moved and grew
+            // Reverse padding sits below the take, so there the loop's own ends are the take's
+            activeSlot.seamFade.store(LoopTrimmer::Markers { activeSlot.takeStart.load(), recordDirection.load() == LoopMode::Reverse ? syncedLength
+                                                                                                   : juce::jmin(recordedLength, syncedLength) }.pack());
+            activeSlot.syncAnchorPpq.store(stopPpq);
+            activeSlot.syncLengthPpq.store(units * unit);
+            activeSlot.syncBpm.store(hostTransport.bpm);
+        }
+    }
+
+    if (action == SyncAction::StopRecordingAndPlay)
+        startPlaybackAfterRecording();
+}
+
+double LooperEngine::getTempoRatio(const LoopSlot& slot) const
+{
+    const double recordedBpm = slot.syncBpm.load();
+
+    if (!canSyncToHost() || slot.syncLengthPpq.load() <= 0.0 || recordedBpm <= 0.0)
+        return 0.0;
+
+    // Past an octave either way the loop free-runs at its recorded rate instead
+    const double ratio = hostTransport.bpm / recordedBpm;
+    return (ratio >= minTempoRatio && ratio <= maxTempoRatio) ? ratio : 0.0;
+}
+
+double LooperEngine::getPlaybackRate(const LoopSlot& slot, float speed) const
+{
+    // Varispeed on top of the slot's own speed; a synced loop is also resampled so it
+    // stays the same number of beats at the host tempo
+    const double ratio = getTempoRatio(slot);
+    return static_cast<double>(speed) * varispeed.load() * ((ratio > 0.0) ? ratio : 1.0);
+}
+
+void LooperEngine::lockSlotsToHost(int startSample)
+{
+    if (!canSyncToHost())
+        return;
+
+    const auto state = currentState.load();
+    const bool activePlaying = (state == LooperState::Playing || state == LooperState::Overdubbing);
+    const bool multiTrack = (playbackMode.load() == PlaybackMode::MultiTrack && state != LooperState::Stopped);
+
+    if (!activePlaying && !multiTrack)
+        return;
+
+    const double ppq = getHostPpqAt(startSample);
+    const int activeIndex = activeLoopSlot.load();
+
+    for (int slotIndex = 0; slotIndex < maxLoopSlots; ++slotIndex)
+    {
+        // Only slots that are actually playing: the active one (unless recording), and the rest in multi-track
+        if ((slotIndex == activeIndex) ? !activePlaying : !multiTrack)
+            continue;
+
+        auto& slot = loopSlots[static_cast<size_t>(slotIndex)];
+        const int slotLength = slot.length.load();
+        const double loopQuarterNotes = slot.syncLengthPpq.load();
+
+        // Only loops recorded in sync that are following the host tempo (see getTempoRatio),
+        // and not while varispeed deliberately pulls them off the grid
+        if (!slot.hasContent.load() || slotLength == 0 || getTempoRatio(slot) <= 0.0 || varispeed.load() != 1.0f)
+            continue;
+
+        // Where the playhead should be: one pass spans loopQuarterNotes / speed on the host
+        // timeline, whatever the tempo, since the loop is stretched to stay that many beats long
+        const double speed = slot.speed.load();
+        const double cycleQuarterNotes = loopQuarterNotes / speed;
+        double phase = std::fmod(ppq - slot.syncAnchorPpq.load(), cycleQuarterNotes) / cycleQuarterNotes;
+        if (phase < 0.0)
+            phase += 1.0;
+
+        double expected = phase * slotLength;
+        if (slot.direction.load() == LoopMode::Reverse)
+            expected = static_cast<double>(slotLength - 1) - expected;
+        if (expected < 0.0)
+            expected += slotLength;
+
+        // Only correct real drift, so the playhead isn't nudged every block by rounding.
+        // At unity speed keep it on a whole sample for the span-copy path.
+        const double current = slot.playPosition.load();
+        const double drift = std::abs(current - expected);
+
+        if (juce::jmin(drift, slotLength - drift) > phaseLockToleranceSamples)
+        {
+            if (getPlaybackRate(slot, slot.speed.load()) == 1.0)
+                expected = std::round(expected);
+
+            slot.playPosition.store((expected >= slotLength) ? 0.0 : expected);
+        }
+    }
+}
+
+int LooperEngine::getCaptureCapacity() const
+{
+    return juce::jmin(maxLoopSamples / 2, static_cast<int>(captureSeconds.load() * sampleRate));
+}
+
+template <typename SampleType>
+void LooperEngine::writeCaptureRing(const juce::AudioBuffer<SampleType>& input)
+{
+    takeResizedCaptureRing();
+
+    // Changing the length (or switching capture off) starts the ring over. Until the worker
+    // has reallocated the ring, it captures what fits.
+    const int capacity = juce::jmin(getCaptureCapacity(), captureRing.getNumSamples() / 2);
+
+    if (capacity != captureCapacity)
+    {
+        captureCapacity = capacity;
+        captureWritePosition = 0;
+        captureFilled = 0;
+    }
+
+    if (captureCapacity <= 0)
+        return;
+
+    const int numSamples = input.getNumSamples();
+    const int channels = juce::jmin(numChannels, input.getNumChannels(), captureRing.getNumChannels());
+
+    // Only the newest capacity samples of an oversized block can survive
+    int done = juce::jmax(0, numSamples - captureCapacity);
+    int position = (captureWritePosition + done) % captureCapacity;
+
+    while (done < numSamples)
+    {
+        const int span = juce::jmin(numSamples - done, captureCapacity - position);
+
+        for (int channel = 0; channel < channels; ++channel)
+        {
+            const SampleType* in = input.getReadPointer(channel, done);
+            StorageType* ring = captureRing.getWritePointer(channel);
+
+            copySamples(ring + position, in, span);
+            copySamples(ring + position + captureCapacity, in, span);  // Mirror half
         }
+
+        done += span;
+        position += span;
+
+        if (position == captureCapacity)
+            position = 0;
     }
-    else
+
+    captureWritePosition = position;
+    captureFilled = juce::jmin(captureCapacity, captureFilled + numSamples);
+}
+
+void LooperEngine::captureIntoActiveSlot(int startSample)
+{
+    const auto state = currentState.load();
+
+    if (captureFilled == 0 || state == LooperState::Recording || state == LooperState::Overdubbing
+        || state == LooperState::ContinuousReverse)
+        return;
+
+    auto& activeSlot = loopSlots[static_cast<size_t>(activeLoopSlot.load())];
+
+    // Capture fills an empty slot only - a loop already there has to be cleared or
+    // re-recorded first, so one press can't throw it away
+    if (activeSlot.hasContent.load())
+        return;
+
+    // The newest sample sits just before captureWritePosition in the mirror half, so the
+    // last captureFilled samples end there, contiguously
+    int loopEnd = captureWritePosition + captureCapacity;
+    int captureLength = captureFilled;
+    double anchorPpq = -1.0;
+    double lengthPpq = 0.0;
+
+    if (canSyncToHost())
     {
-        currentPos += speed;
-        // Wrap to beginning when going past end
-        if (currentPos >= length)
+        // Whole bars/beats, ending on the last boundary the host has passed
+        const double unit = getSyncUnitQuarterNotes();
+        const double samplesPerQuarter = getSamplesPerQuarterNote();
+        const double nowPpq = getHostPpqAt(startSample);
+        const double boundaryPpq = std::floor(nowPpq / unit) * unit;
+        const int sinceBoundary = static_cast<int>(std::round((nowPpq - boundaryPpq) * samplesPerQuarter));
+        const double units = std::floor((captureFilled - sinceBoundary) / (unit * samplesPerQuarter));
+
+        if (units >= 1.0)
         {
-            currentPos = 0.0f;
-            wrapped = true;
+            loopEnd -= sinceBoundary;
+            captureLength = static_cast<int>(std::round(units * unit * samplesPerQuarter));
+            anchorPpq = boundaryPpq;
+            lengthPpq = units * unit;
         }
     }
 
-    position.store(currentPos);
-    return wrapped;
+    // The slot takes the ring's buffer as it is and the ring carries on in the slot's old one.
+    // If the worker is reading the slot's buffer right now, capture on the next chunk.
+    if (activeSlot.bufferInUse.exchange(true, std::memory_order_acquire))
+    {
+        captureRequested.store(true);
+        return;
+    }
+
+    std::swap(activeSlot.buffer, captureRing);
+    activeSlot.bufferInUse.store(false, std::memory_order_release);
+
+    const int activeIndex = getSlotIndex(activeSlot);
+    if (captureBufferOwner < 0)
+        captureBufferOwner = activeIndex;
+    else if (captureBufferOwner == activeIndex)
+        captureBufferOwner = -1;
+
+    captureRingSamples.store(captureBufferOwner < 0 ? captureRing.getNumSamples() : -1);
+    captureWritePosition = 0;
+    captureFilled = 0;
+
+    // The span is contiguous thanks to the mirror
+    const int captureStart = loopEnd - captureLength;
+    activeSlot.takeStart.store(captureStart);
+    activeSlot.takeLength.store(captureLength);
+    activeSlot.loopStart.store(captureStart);
+    activeSlot.trimRequested.store(false);
+    activeSlot.pagesStale.store(true);
+    activeSlot.overviewStale.store(true);
+    ++activeSlot.takeRevision;
+    activeSlot.length.store(captureLength);
+    activeSlot.hasContent.store(true);
+    activeSlot.isRecording.store(false);
+    activeSlot.direction.store(loopMode.load());
+    activeSlot.speed.store(getSpeedMultiplier());
+    activeSlot.syncLengthPpq.store(lengthPpq);
+    activeSlot.seamFade.store(LoopTrimmer::Markers { captureStart, captureLength }.pack());
+
+    if (lengthPpq > 0.0)
+    {
+        activeSlot.syncAnchorPpq.store(anchorPpq);
+        activeSlot.syncBpm.store(hostTransport.bpm);
+    }
+
+    startPlayback();
+}
+
+void LooperEngine::takeResizedCaptureRing()
+{
+    if (!captureRingResized.load(std::memory_order_acquire))
+        return;
+
+    // Only while the ring holds the ring-sized buffer, so there is never more than one.
+    // Either way the worker frees what is left in resizedCaptureRing.
+    if (captureBufferOwner < 0)
+    {
+        std::swap(captureRing, resizedCaptureRing);
+        captureWritePosition = 0;
+        captureFilled = 0;
+        captureRingSamples.store(captureRing.getNumSamples());
+    }
+
+    captureRingResized.store(false, std::memory_order_release);
+}
+
+bool LooperEngine::reclaimSlotBuffer(LoopSlot& slot)
+{
+    if (captureBufferOwner != getSlotIndex(slot))
+        return true;
+
+    if (slot.bufferInUse.exchange(true, std::memory_order_acquire))
+        return false;
+
+    // The ring's pre-roll goes with it: the slot's old loop is what the ring holds now
+    std::swap(slot.buffer, captureRing);
+    slot.bufferInUse.store(false, std::memory_order_release);
+
+    captureBufferOwner = -1;
+    captureWritePosition = 0;
+    captureFilled = 0;
+    captureRingSamples.store(captureRing.getNumSamples());
+    return true;
+}
+
+void LooperEngine::resizeCaptureRing()
+{
+    // The audio thread hasn't taken the last one yet
+    if (captureRingResized.load(std::memory_order_acquire))
+        return;
+
+    // Whatever is left was swapped out of the ring, or arrived too late to be used
+    if (resizedCaptureRing.getNumChannels() > 0)
+        resizedCaptureRing = juce::AudioBuffer<StorageType>();
+
+    const int ringSamples = captureRingSamples.load();
+    const int wanted = 2 * getCaptureCapacity();
+
+    if (ringSamples < 0 || ringSamples == wanted)
+        return;
+
+    resizedCaptureRing.setSize(numChannels, wanted);
+    resizedCaptureRing.clear();
+    captureRingResized.store(true, std::memory_order_release);
+}
+
+void LooperEngine::addAutomationEvent(AutomatedParameter parameter, int sampleOffset, float value)
+{
+    // A block with more events than this keeps the earlier ones; the parameter's
+    // block-rate value catches up on the next block
+    if (numAutomationEvents < maxAutomationEvents)
+        automationEvents[static_cast<size_t>(numAutomationEvents++)] = { parameter, juce::jmax(0, sampleOffset), value };
+}
+
+void LooperEngine::applyAutomationEvents(int startSample)
+{
+    while (nextAutomationEvent < numAutomationEvents
+           && automationEvents[static_cast<size_t>(nextAutomationEvent)].sampleOffset <= startSample)
+    {
+        const auto& event = automationEvents[static_cast<size_t>(nextAutomationEvent++)];
+
+        if (event.parameter == AutomatedParameter::Volume)
+            outputVolume.store(event.value);
+        else
+            feedbackAmount.store(event.value);
+
+        // The kernels ramp to the new value over the sub-block that starts here
+        automationRampEnd = startSample + fadeSamples;
+    }
+}
+
+int LooperEngine::getAutomationOffset(int startSample, int numSamples) const
+{
+    int offset = -1;
+
+    if (nextAutomationEvent < numAutomationEvents)
+    {
+        const int eventOffset = automationEvents[static_cast<size_t>(nextAutomationEvent)].sampleOffset - startSample;
+
+        if (eventOffset < numSamples)
+            offset = eventOffset;
+    }
+
+    const int rampOffset = automationRampEnd - startSample;
+
+    if (rampOffset > 0 && rampOffset < numSamples && (offset < 0 || rampOffset < offset))
+        offset = rampOffset;
+
+    return offset;
+}
+
+void LooperEngine::finishAutomationEvents()
+{
+    // The CC values stay in the engine rather than being written back to the host
+    // parameters, where a host in touch/latch would record them. The UI shows them
+    // from the state snapshot, and the next host change takes over from them.
+    numAutomationEvents = 0;
+    nextAutomationEvent = 0;
+    automationRampEnd = -1;
+}
+
+void LooperEngine::publishStateSnapshot()
+{
+    // One store per block; readers get every field from the same block or retry
+    const auto& activeSlot = loopSlots[static_cast<size_t>(activeLoopSlot.load())];
+
+    if (loopWrapped.exchange(false))
+        ++loopWrapCount;
+
+    StateSnapshot snapshot;
+    snapshot.state = currentState.load();
+    snapshot.loopMode = loopMode.load();
+    snapshot.onceMode = onceMode.load();
+    snapshot.stackMode = stackMode.load();
+    snapshot.speedMode = speedMode.load();
+    snapshot.thruMute = thruMute.load();
+    snapshot.playbackMode = playbackMode.load();
+    snapshot.syncMode = syncMode.load();
+    snapshot.waitingForSync = (pendingSyncAction.load() != SyncAction::None);
+    snapshot.followingTransport = transportFollow.load();
+    snapshot.timeStretching = timeStretch.load();
+    snapshot.activeLoopSlot = static_cast<std::uint8_t>(activeLoopSlot.load());
+    snapshot.loopProgress = getLoopProgress();
+    snapshot.loopLength = activeSlot.length.load();
+    snapshot.loopWraps = loopWrapCount;
+    snapshot.volume = outputVolume.load();
+    snapshot.feedback = feedbackAmount.load();
+    snapshot.varispeed = varispeed.load();
+    snapshot.timeStretchLoad = static_cast<float>(timeStretchLoad.getLoadAsProportion());
+    snapshot.captureSeconds = captureSeconds.load();
+    snapshot.meters = currentMeterLevels;
+    stateSnapshot.store(snapshot);
+}
+
+bool LooperEngine::getSeamGains(const LoopSlot& slot, double startPosition, double step, int numSamples, float* gains) const
+{
+    const auto fade = LoopTrimmer::Markers::unpack(slot.seamFade.load());
+    const int length = slot.length.load();
+
+    // Takes shorter than two fades use a sparser walk through the tables
+    const int fadeCount = juce::jmin(fadeSamples, fade.length / 2);
+
+    if (fadeCount == 0 || length == 0)
+        return false;
+
+    const int tableStride = fadeSamples / fadeCount;
+    const int fadeOutStart = fade.length - fadeCount;
+    const int loopStart = slot.loopStart.load();
+
+    // Where a loop position falls in the fade span, which repeats every fade.length
+    auto getPhase = [&](double position)
+    {
+        const int phase = (loopStart + static_cast<int>(position) - fade.start) % fade.length;
+        return (phase < 0) ? phase + fade.length : phase;
+    };
+
+    // Steady playback between the seams pays for this test only
+    const double travel = step * static_cast<double>(numSamples);
+    const double endPosition = startPosition + travel;
+
+    if (endPosition >= 0.0 && endPosition < static_cast<double>(length))
+    {
+        const double startPhase = getPhase(startPosition);
+        const double lowestPhase = juce::jmin(startPhase, startPhase + travel);
+        const double highestPhase = juce::jmax(startPhase, startPhase + travel);
+
+        if (lowestPhase >= fadeCount && highestPhase + 1.0 < fadeOutStart)
+            return false;
+    }
+
+    double position = startPosition;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const int phase = getPhase(position);
+
+        if (phase < fadeCount)
+            gains[i] = fadeInTable[phase * tableStride];
+        else if (phase >= fadeOutStart)
+            gains[i] = fadeOutTable[(phase - fadeOutStart) * tableStride];
+        else
+            gains[i] = 1.0f;
+
+        position += step;
+
+        if (position >= static_cast<double>(length))
+            position -= static_cast<double>(length);
+        else if (position < 0.0)
+            position += static_cast<double>(length);
+    }
+
+    return true;
+}
+
+template <typename SampleType>
+void LooperEngine::applySeamFade(const LoopSlot& slot, juce::AudioBuffer<SampleType>& dest, int channels, int numSamples,
+                                 double startPosition, double step)
+{
+    // readSlot() has finished with the block's weights, so the gains can go there
+    float* gains = blockWeights.get();
+
+    if (!getSeamGains(slot, startPosition, step, numSamples, gains))
+        return;
+
+    for (int channel = 0; channel < channels; ++channel)
+    {
+        SampleType* out = dest.getWritePointer(channel);
+
+        for (int i = 0; i < numSamples; ++i)
+            out[i] *= static_cast<SampleType>(gains[i]);
+    }
+}
+
+void LooperEngine::scanPendingTrims()
+{
+    for (auto& slot : loopSlots)
+    {
+        if (!slot.trimRequested.exchange(false))
+            continue;
+
+        const int revision = slot.takeRevision.load();
+        const int takeStart = slot.takeStart.load();
+        const int length = slot.takeLength.load();
+
+        // Synced loops keep their whole bars
+        if (length == 0 || slot.isRecording.load() || slot.syncLengthPpq.load() > 0.0)
+            continue;
+
+        // A swap after this leaves the pointers valid (only this thread frees buffers) but
+        // bumps takeRevision, so the proposal below is dropped
+        auto view = lockBufferView(slot);
+
+        if (takeStart + length > view.numSamples)
+            continue;
+
+        for (int channel = 0; channel < view.numChannels; ++channel)
+            view.channels[static_cast<size_t>(channel)] += takeStart;
+
+        const auto markers = LoopTrimmer::findAudibleRegion(view.channels.data(), view.numChannels, length, sampleRate);
+
+        // Silent throughout, or nothing to drop
+        if (markers.length == 0 || markers.length == length)
+            continue;
+
+        proposeLoopMarkers(slot, markers.start, markers.start + markers.length, revision);
+    }
+}
+
+void LooperEngine::rebuildStaleOverviews()
+{
+    // The whole buffer changed under the slot (capture, reset, padding): redraw it all from the take
+    for (auto& slot : loopSlots)
+    {
+        if (!slot.overviewStale.exchange(false))
+            continue;
+
+        const int takeStart = slot.takeStart.load();
+        const auto view = lockBufferView(slot);
+        updateOverview(slot, view, 0, view.numSamples, takeStart, takeStart + slot.takeLength.load());
+    }
+}
+
+LooperEngine::BufferView LooperEngine::getBufferView(const LoopSlot& slot)
+{
+    BufferView view;
+    view.numChannels = juce::jmin(maxChannels, slot.buffer.getNumChannels());
+    view.numSamples = slot.buffer.getNumSamples();
+
+    for (int channel = 0; channel < view.numChannels; ++channel)
+        view.channels[static_cast<size_t>(channel)] = slot.buffer.getReadPointer(channel);
+
+    return view;
+}
+
+LooperEngine::BufferView LooperEngine::lockBufferView(LoopSlot& slot)
+{
+    // Held for a few loads; the audio thread never waits on it
+    while (slot.bufferInUse.exchange(true, std::memory_order_acquire))
+        std::this_thread::yield();
+
+    const auto view = getBufferView(slot);
+    slot.bufferInUse.store(false, std::memory_order_release);
+    return view;
+}
+
+void LooperEngine::updateOverview(LoopSlot& slot, const BufferView& view, int from, int to, int validFrom, int validTo)
+{
+    slot.overview.update(view.channels.data(), view.numChannels, from, juce::jmin(to, view.numSamples), validFrom, validTo);
+}
+
+void LooperEngine::updateLoopOverview(LoopSlot& slot, int from, int numSamples)
+{
+    // Loop-relative, wrapping at the seam, like materializeLoopRange
+    const int length = slot.length.load();
+    const int loopStart = slot.loopStart.load();
+    const int takeStart = slot.takeStart.load();
+    const int takeEnd = takeStart + slot.takeLength.load();
+
+    numSamples = juce::jmin(numSamples, length);
+
+    if (numSamples <= 0)
+        return;
+
+    const int toEnd = juce::jmin(numSamples, length - from);
+    const auto view = getBufferView(slot);
+    updateOverview(slot, view, loopStart + from, loopStart + from + toEnd, takeStart, takeEnd);
+
+    if (numSamples > toEnd)
+        updateOverview(slot, view, loopStart, loopStart + numSamples - toEnd, takeStart, takeEnd);
+}
+
+void LooperEngine::applyPendingMarkers()
+{
+    // New markers are applied at the playhead's next pass over the seam, where the old loop
+    // would have wrapped anyway, or straight away if the slot is silent
+    const auto* stackedSlot = (stackMode.load() == StackMode::On) ? &loopSlots[static_cast<size_t>(activeLoopSlot.load())] : nullptr;
+
+    for (auto& slot : loopSlots)
+    {
+        const bool crossedSeam = slot.crossedSeam;
+        slot.crossedSeam = false;
+
+        // A new take (or capture) starts with every position real
+        if (slot.pagesStale.exchange(false))
+            slot.pages.reset();
+
+        if (slot.isRecording.load() || slot.fadeOutGain.load() > 0.0f || &slot == stackedSlot)
+            continue;
+
+        // Multiplying leaves the playhead where it is, so it needn't wait for the seam
+        if (const int factor = slot.pendingMultiply.exchange(0); factor > 1)
+            multiplySlot(slot, factor);
+
+        const bool audible = slot.isPlaying.load() || playbackMode.load() == PlaybackMode::MultiTrack;
+        if (audible && !crossedSeam)
+            continue;
+
+        if (const int factor = slot.pendingDivide.exchange(0); factor > 1)
+            divideSlot(slot, factor);
+
+        if (slot.pendingMarkers.load() == 0)
+            continue;
+
+        const auto markers = LoopTrimmer::Markers::unpack(slot.pendingMarkers.exchange(0));
+        const int revision = slot.pendingMarkersRevision.load();
+
+        if ((revision != anyRevision && revision != slot.takeRevision.load()) || slot.syncLengthPpq.load() > 0.0
+            || markers.length <= 0 || markers.start + markers.length > slot.takeLength.load())
+            continue;
+
+        // Only the markers move; the playhead keeps its place in the take where it can
+        const int newLoopStart = slot.takeStart.load() + markers.start;
+        const double takePosition = slot.loopStart.load() + slot.playPosition.load();
+
+        slot.loopStart.store(newLoopStart);
+        slot.length.store(markers.length);
+        slot.playPosition.store(juce::jlimit(0.0, static_cast<double>(markers.length - 1), takePosition - newLoopStart));
+
+        // The new seam is faded like a new take's
+        slot.seamFade.store(LoopTrimmer::Markers { newLoopStart, markers.length }.pack());
+    }
+}
+
+void LooperEngine::multiplyLoop(int factor)
+{
+    if (factor > 1)
+        loopSlots[static_cast<size_t>(activeLoopSlot.load())].pendingMultiply.store(factor);
+}
+
+void LooperEngine::divideLoop(int factor)
+{
+    if (factor > 1)
+        loopSlots[static_cast<size_t>(activeLoopSlot.load())].pendingDivide.store(factor);
+}
+
+void LooperEngine::multiplySlot(LoopSlot& slot, int factor)
+{
+    const int length = slot.length.load();
+    const int loopStart = slot.loopStart.load();
+    const int loopOffset = loopStart - slot.takeStart.load();
+
+    if (!slot.hasContent.load() || length == 0)
+        return;
+
+    // The repeats turn real in place as they're overdubbed, so they need room in the buffer.
+    // They go above the loop where they fit, and below it for a take that ends at the top
+    // of the buffer (a reverse recording); the loop then starts on its first repeat, which
+    // plays the same audio, so the playhead stays where it is either way.
+    const int roomAbove = (slot.buffer.getNumSamples() - loopStart) / length;
+    const int roomBelow = loopStart / length + 1;
+    const bool below = slot.pages.growsDownwards() || (slot.pages.isIdentity() && roomAbove < factor && roomBelow > roomAbove);
+    factor = juce::jmin(factor, below ? roomBelow : roomAbove);
+
+    if (factor < 2 || !(below ? multiplyBelow(slot, factor) : slot.pages.addRepeats(loopOffset, loopOffset + length, loopOffset + length * factor)))
+    {
+        // No room either side of the loop, or no level left: the press is refused, and the
+        // button drops back to show it
+        if (parameterNotifyCallback)
+            parameterNotifyCallback(ParameterIDs::multiply, 0.0f);
+
+        return;
+    }
+
+    if (!below)
+    {
+        slot.takeLength.store(loopOffset + length * factor);
+        slot.overview.copyRepeats(loopStart, loopStart + length, loopStart + length * factor, slot.takeStart.load(), loopStart + length * factor);
+    }
+
+    slot.length.store(length * factor);
+    ++slot.takeRevision;
+
+    // A synced loop stays locked to the host, over more bars
+    if (const double lengthPpq = slot.syncLengthPpq.load(); lengthPpq > 0.0)
+        slot.syncLengthPpq.store(lengthPpq * factor);
+}
+
+bool LooperEngine::multiplyBelow(LoopSlot& slot, int factor)
+{
+    const int length = slot.length.load();
+    const int loopStart = slot.loopStart.load();
+    const int takeStart = slot.takeStart.load();
+    const int takeEnd = takeStart + slot.takeLength.load();
+    const int newLoopStart = loopStart - length * (factor - 1);
+    const int newTakeStart = juce::jmin(takeStart, newLoopStart);
+
+    if (!slot.pages.addRepeatsBelow(newLoopStart - newTakeStart, loopStart - newTakeStart, loopStart + length - newTakeStart, takeEnd - newTakeStart))
+        return false;
+
+    slot.takeStart.store(newTakeStart);
+    slot.takeLength.store(takeEnd - newTakeStart);
+    slot.loopStart.store(newLoopStart);
+    slot.overview.copyRepeatsBelow(newLoopStart, loopStart, loopStart + length, newTakeStart, takeEnd);
+    return true;
+}
+
+void LooperEngine::divideSlot(LoopSlot& slot, int factor)
+{
+    const int length = slot.length.load() / factor;
+
+    if (!slot.hasContent.load() || length == 0)
+        return;
+
+    // Keeps the first part of the loop: only the end marker moves
+    slot.length.store(length);
+    slot.playPosition.store(std::fmod(slot.playPosition.load(), static_cast<double>(length)));
+
+    if (const double lengthPpq = slot.syncLengthPpq.load(); lengthPpq > 0.0)
+        slot.syncLengthPpq.store(lengthPpq / factor);
+}
+
+std::array<LooperEngine::StorageType*, LooperEngine::maxChannels> LooperEngine::getTakeData(LoopSlot& slot)
+{
+    std::array<StorageType*, maxChannels> take {};
+
+    for (int channel = 0; channel < slot.buffer.getNumChannels(); ++channel)
+        take[static_cast<size_t>(channel)] = slot.buffer.getWritePointer(channel, slot.takeStart.load());
+
+    return take;
+}
+
+void LooperEngine::materializeLoopRange(LoopSlot& slot, int from, int numSamples)
+{
+    // Loop-relative, wrapping at the seam; the page map works on the take
+    const int length = slot.length.load();
+    const int loopOffset = slot.loopStart.load() - slot.takeStart.load();
+    const auto take = getTakeData(slot);
+
+    numSamples = juce::jmin(numSamples, length);
+    const int toEnd = juce::jmin(numSamples, length - from);
+
+    slot.pages.materialize(take.data(), slot.buffer.getNumChannels(), loopOffset + from, toEnd);
+
+    if (numSamples > toEnd)
+        slot.pages.materialize(take.data(), slot.buffer.getNumChannels(), loopOffset, numSamples - toEnd);
+}
+
+void LooperEngine::setLoopMarkers(int slotIndex, int startSample, int endSample)
+{
+    proposeLoopMarkers(loopSlots[static_cast<size_t>(juce::jlimit(0, maxLoopSlots - 1, slotIndex))], startSample, endSample, anyRevision);
+}
+
+void LooperEngine::restoreWholeTake()
+{
+    const int slotIndex = activeLoopSlot.load();
+    setLoopMarkers(slotIndex, 0, getTakeLength(slotIndex));
+}
+
+void LooperEngine::proposeLoopMarkers(LoopSlot& slot, int startSample, int endSample, int revision)
+{
+    // Markers set by hand and the loop worker's trims both land here, for applyPendingMarkers()
+    const int takeLength = slot.takeLength.load();
+
+    if (takeLength == 0)
+        return;
+
+    const int start = juce::jlimit(0, takeLength - 1, startSample);
+    const int end = juce::jlimit(start + 1, takeLength, endSample);
+
+    // The revision goes first, so the audio thread sees the one this proposal belongs to
+    slot.pendingMarkersRevision.store(revision);
+    slot.pendingMarkers.store(LoopTrimmer::Markers { start, end - start }.pack());
+}
+
+int LooperEngine::getLoopStartMarker(int slotIndex) const
+{
+    const auto& slot = loopSlots[static_cast<size_t>(juce::jlimit(0, maxLoopSlots - 1, slotIndex))];
+    return slot.loopStart.load() - slot.takeStart.load();
+}
+
+int LooperEngine::getLoopEndMarker(int slotIndex) const
+{
+    return getLoopStartMarker(slotIndex) + loopSlots[static_cast<size_t>(juce::jlimit(0, maxLoopSlots - 1, slotIndex))].length.load();
+}
+
+void LooperEngine::getLoopWaveform(int slotIndex, int startSample, int numSamples, int numPoints, float* mins, float* maxs) const
+{
+    const auto& slot = loopSlots[static_cast<size_t>(juce::jlimit(0, maxLoopSlots - 1, slotIndex))];
+    slot.overview.read(slot.loopStart.load() + startSample, numSamples, numPoints, mins, maxs);
+}
+
+int LooperEngine::findNextEmptyLoopSlot() const
+{
+    for (int step = 1; step < maxLoopSlots; ++step)
+    {
+        const int slotIndex = (activeLoopSlot.load() + step) % maxLoopSlots;
+
+        if (!loopSlots[static_cast<size_t>(slotIndex)].hasContent.load())
+            return slotIndex;
+    }
+
+    return -1;
+}
+
+void LooperEngine::switchToLoopSlot(int slotIndex)
+{
+    activeLoopSlot = slotIndex;
+
+    if (parameterNotifyCallback)
+        parameterNotifyCallback(ParameterIDs::loopSlot, static_cast<float>(slotIndex + 1));
 }
 
-void LooperEngine::switchToNextLoopSlot()
+void LooperEngine::restartAllSlots()
 {
-    activeLoopSlot = (activeLoopSlot + 1) % maxLoopSlots;
+    for (auto& slot : loopSlots)
+    {
+        const int slotLength = slot.length.load();
+        slot.playPosition.store((slot.direction.load() == LoopMode::Reverse && slotLength > 0)
+            ? static_cast<double>(slotLength - 1)
+            : 0.0);
+    }
 }
 
 float LooperEngine::getLoopProgress() const
@@ -701,5 +2932,10 @@ float LooperEngine::getLoopProgress() const
     if (!activeSlot.hasContent.load() || activeSlot.length.load() == 0)
         return 0.0f;
     
-    return activeSlot.playPosition.load() / static_cast<float>(activeSlot.length.load());
+    return static_cast<float>(activeSlot.playPosition.load() / static_cast<double>(activeSlot.length.load()));
 }
+
+//==============================================================================
+// processBlock() is defined here, so instantiate both host precisions explicitly
+template void LooperEngine::processBlock<float>(juce::AudioBuffer<float>&, SlotOutputs<float>*);
+template void LooperEngine::processBlock<double>(juce::AudioBuffer<double>&, SlotOutputs<double>*);
@@ -3,7 +3,25 @@
 #include <juce_audio_basics/juce_audio_basics.h>
 #include <juce_dsp/juce_dsp.h>
 #include <atomic>
+#include <cstdint>
 #include <functional>
+#include <type_traits>
+#include "DecayFilter.h"
+#include "HalfbandDecimator.h"
+#include "LevelMeter.h"
+#include "LoopPages.h"
+#include "LoopTrimmer.h"
+#include "SeqLock.h"
+#include "SincTable.h"
+#include "SoftLimiter.h"
+#include "TimeStretcher.h"
+#include "WaveformOverview.h"
+
+// Loop storage precision, independent of the precision the host processes in.
+// Set by the BOOMERANG_DOUBLE_PRECISION_LOOPS CMake option; defaults to float storage.
+#ifndef BOOMERANG_DOUBLE_PRECISION_LOOPS
+ #define BOOMERANG_DOUBLE_PRECISION_LOOPS 0
+#endif
 
 //==============================================================================
 /**
@@ -22,9 +40,11 @@ class LooperEngine
 {
 public:
     //==============================================================================
-    enum class LooperState
+    // State and mode enums are a byte each, so the published StateSnapshot stays small
+    enum class LooperState : std::uint8_t
     {
         Stopped,
+        Armed,          // Waiting for input over the trigger threshold to start recording
         Recording,
         Playing,
         Overdubbing,
@@ -32,7 +52,7 @@ public:
         BufferFilled
     };
 
-    enum class LoopMode
+    enum class LoopMode : std::uint8_t
     {
         Normal,
         Reverse,
@@ -44,30 +64,62 @@ public:
         Reverse
     };
 
-    enum class StackMode
+    enum class StackMode : std::uint8_t
     {
         Off,
         On
     };
 
-    enum class OnceMode
+    enum class OnceMode : std::uint8_t
     {
         Off,
         On
     };
 
-    enum class ThruMuteState
+    enum class ThruMuteState : std::uint8_t
     {
         Off,
         On
     };
 
-    enum class SpeedMode
+    enum class SpeedMode : std::uint8_t
     {
         Normal,
         Half
     };
 
+    enum class PlaybackMode : std::uint8_t
+    {
+        Single,      // Only the active loop slot plays
+        MultiTrack   // Every recorded loop slot plays at once
+    };
+
+    enum class SyncMode : std::uint8_t
+    {
+        Off,    // Free-form recording
+        Bars,   // Record stop and loop length quantized to whole bars
+        Beats   // Record stop and loop length quantized to whole beats
+    };
+
+    // Host transport at the first sample of the next processBlock() call
+    struct HostTransport
+    {
+        bool hasTempo = false;
+        double bpm = 120.0;
+        int numerator = 4;
+        int denominator = 4;
+        bool hasPpq = false;
+        double ppqPosition = 0.0;   // Position in quarter notes
+        bool isPlaying = false;
+    };
+
+    //==============================================================================
+    static constexpr int maxLoopSlots = 4;
+    static constexpr int maxChannels = 8;  // Discrete loop channels (e.g. quad, 5.1, 7.1)
+
+    // Sample type the loops are stored in (see BOOMERANG_DOUBLE_PRECISION_LOOPS)
+    using StorageType = std::conditional_t<BOOMERANG_DOUBLE_PRECISION_LOOPS != 0, double, float>;
+
     //==============================================================================
     LooperEngine();
     ~LooperEngine();
@@ -77,7 +129,14 @@ public:
     void reset();
 
     //==============================================================================
-    void processBlock(juce::AudioBuffer<float>& buffer);
+    // Optional per-slot destinations, one per loop slot. A slot whose entry has channels
+    // is rendered straight into it (e.g. a host aux bus) instead of the main output.
+    template <typename SampleType>
+    using SlotOutputs = std::array<juce::AudioBuffer<SampleType>, maxLoopSlots>;
+
+    // Instantiated for float and double so the host's buffer is processed in its own precision
+    template <typename SampleType>
+    void processBlock(juce::AudioBuffer<SampleType>& buffer, SlotOutputs<SampleType>* slotOutputs = nullptr);
 
     //==============================================================================
     // Button event handlers
@@ -88,11 +147,74 @@ public:
     void onStackButtonPressed();      // Momentary: called when pressed
     void onStackButtonReleased();     // Momentary: called when released
     void onReverseButtonPressed();
+    void onCaptureButtonPressed();    // Turn the last captureSeconds (or whole bars) of input into a loop
+
+    //==============================================================================
+    // Loop slot selection and multi-track playback
+    void selectLoopSlot(int slotIndex);
+    void setPlaybackMode(PlaybackMode mode) { playbackMode.store(mode); }
+    void setSlotGain(int slotIndex, float gain);
+
+    // Loop markers, in samples from the start of the slot's take (end exclusive). Setting them
+    // only moves where the loop starts and wraps - the take's audio is kept, so they can be
+    // widened again later. Applied at the loop's next seam; synced loops keep their length.
+    void setLoopMarkers(int slotIndex, int startSample, int endSample);
+    void restoreWholeTake();    // The active slot's markers back out to its whole take (undoes a trim)
+    int getLoopStartMarker(int slotIndex) const;
+    int getLoopEndMarker(int slotIndex) const;
+    // Multiply repeats the active loop factor times, at once and without copying it; divide
+    // keeps its first 1/factor from the next seam. A synced loop's bar count follows.
+    void multiplyLoop(int factor);
+    void divideLoop(int factor);
+
+    int getTakeLength(int slotIndex) const { return loopSlots[static_cast<size_t>(juce::jlimit(0, maxLoopSlots - 1, slotIndex))].takeLength.load(); }
+
+    // Waveform of part of a slot's loop, for display: the min and max of each of numPoints
+    // equal columns of the numSamples from startSample (loop-relative). Read from the slot's
+    // overview pyramid, so any thread can call it and the loop audio is never touched.
+    void getLoopWaveform(int slotIndex, int startSample, int numSamples, int numPoints, float* mins, float* maxs) const;
+
+    //==============================================================================
+    // Host tempo sync (issue #20)
+    void setSyncMode(SyncMode mode) { syncMode.store(mode); }
+    // Start/stop with the host transport, on the next bar (or beat in Beats sync mode)
+    void setTransportFollow(bool shouldFollow) { transportFollow.store(shouldFollow); }
+    // Audio thread only: call before each processBlock()
+    void setHostTransport(const HostTransport& transport) { hostTransport = transport; }
 
     //==============================================================================
     // Parameter setters
     void setVolume(float volume) { outputVolume.store(volume); }
     void setFeedback(float feedback) { feedbackAmount.store(feedback); }
+    // Tape-style decay: each overdub pass turns the loop under it down by decayDecibels and,
+    // below DecayFilter::maxToneHz, low-passes it at toneHz
+    void setOverdubDecay(float decayDecibels, float toneHz) { overdubDecay.store(decayDecibels); overdubTone.store(toneHz); }
+    static constexpr float minOverdubDecay = -12.0f;
+    static constexpr float defaultOverdubDecay = -2.5f;
+    // Soft limit: overdubbed loop audio bends into SoftLimiter's ceiling instead of growing past full scale
+    void setSoftLimit(bool shouldLimit) { softLimit.store(shouldLimit); }
+    void setVarispeed(float speed) { varispeed.store(juce::jlimit(minVarispeed, maxVarispeed, speed)); }
+    // Auto-start: Record arms instead, and recording begins on the first input sample over triggerThreshold
+    void setAutoStart(bool shouldAutoStart) { autoStart.store(shouldAutoStart); }
+    static constexpr float triggerThreshold = 0.005f;
+    // Auto-trim: a finished take's silent head and tail are dropped at its next loop seam
+    void setAutoTrim(bool shouldTrim) { autoTrim.store(shouldTrim); }
+    // Keep pitch: non-unity playback rates are time-stretched instead of resampled
+    void setTimeStretch(bool shouldStretch) { timeStretch.store(shouldStretch); }
+
+    // Retroactive capture: while the length is non-zero the input is always written to a
+    // pre-roll ring, up to maxCaptureSeconds long (0 = off)
+    void setCaptureLength(int seconds) { captureSeconds.store(juce::jlimit(0, maxCaptureSeconds, seconds)); }
+    static constexpr int maxCaptureSeconds = 120;
+
+    // Sample-accurate automation (audio thread only): queue a block's events, in time order,
+    // before processBlock(). The block is split at each event so the value lands on its sample.
+    enum class AutomatedParameter { Volume, Feedback };
+    void addAutomationEvent(AutomatedParameter parameter, int sampleOffset, float value);
+    static constexpr int maxAutomationEvents = 64;
+
+    static constexpr float minVarispeed = 0.25f;
+    static constexpr float maxVarispeed = 4.0f;
 
     //==============================================================================
     // State queries for UI updates (thread-safe via atomic loads)
@@ -103,17 +225,67 @@ public:
     OnceMode getOnceMode() const { return onceMode.load(); }
     ThruMuteState getThruMuteState() const { return thruMute.load(); }
     SpeedMode getSpeedMode() const { return speedMode.load(); }
+    PlaybackMode getPlaybackMode() const { return playbackMode.load(); }
+    float getVarispeed() const { return varispeed.load(); }
+    bool isTimeStretching() const { return timeStretch.load(); }
+    // Time spent in one stretcher call, as a proportion of the audio it rendered
+    double getTimeStretchLoad() const { return timeStretchLoad.getLoadAsProportion(); }
+    SyncMode getSyncMode() const { return syncMode.load(); }
+    bool isFollowingTransport() const { return transportFollow.load(); }
+    bool isWaitingForSync() const { return pendingSyncAction.load() != SyncAction::None; }
+    int getCaptureLength() const { return captureSeconds.load(); }
+    bool isAutoStartEnabled() const { return autoStart.load(); }
+    bool isAutoTrimEnabled() const { return autoTrim.load(); }
+    bool isSoftLimiting() const { return softLimit.load(); }
 
-    bool isRecording() const { auto state = currentState.load(); return state == LooperState::Recording || state == LooperState::Overdubbing; }
-    bool isPlaying() const { auto state = currentState.load(); return state == LooperState::Playing || state == LooperState::Overdubbing; }
+    bool isRecording() const { auto state = currentState.load(); return state == LooperState::Recording || state == LooperState::Overdubbing || state == LooperState::ContinuousReverse; }
+    bool isPlaying() const
+    {
+        auto state = currentState.load();
+        return state == LooperState::Playing || state == LooperState::Overdubbing
+            || state == LooperState::ContinuousReverse || state == LooperState::BufferFilled;
+    }
     float getLoopProgress() const;
     int getCurrentLoopSlot() const { return activeLoopSlot.load(); }
-    
-    // Check and clear loop wrap flag for UI flash indicator
-    bool checkAndClearLoopWrapped() 
-    { 
-        return loopWrapped.exchange(false); 
-    }
+
+    // Levels of the input, of the loops (every slot heard, summed in power) and of the output
+    struct MeterLevels
+    {
+        LevelMeter::Level input;
+        LevelMeter::Level loop;
+        LevelMeter::Level output;
+    };
+
+    // What the editor and the host notifications show, published together at the end of
+    // each block so nothing read from it can tear between two blocks
+    struct StateSnapshot
+    {
+        LooperState state = LooperState::Stopped;
+        LoopMode loopMode = LoopMode::Normal;
+        OnceMode onceMode = OnceMode::Off;
+        StackMode stackMode = StackMode::Off;
+        SpeedMode speedMode = SpeedMode::Normal;
+        ThruMuteState thruMute = ThruMuteState::Off;
+        PlaybackMode playbackMode = PlaybackMode::Single;
+        SyncMode syncMode = SyncMode::Off;
+        bool waitingForSync = false;
+        bool followingTransport = false;
+        bool timeStretching = false;
+        std::uint8_t activeLoopSlot = 0;
+        float loopProgress = 0.0f;
+        int loopLength = 0;             // Active slot, between its markers
+        std::uint32_t loopWraps = 0;    // Counts loop wraps: a change means the loop wrapped
+        float volume = 1.0f;            // As played: a MIDI CC may have moved them off the host parameters
+        float feedback = 0.5f;
+        float varispeed = 1.0f;
+        float timeStretchLoad = 0.0f;   // Proportion of the block time the phase vocoder took
+        int captureSeconds = 0;
+        MeterLevels meters;
+    };
+
+    // Any thread: the state as of the end of the last processed block
+    StateSnapshot getStateSnapshot() const { return stateSnapshot.load(); }
+    MeterLevels getMeterLevels() const { return stateSnapshot.load().meters; }
     
     // Callback for notifying host of parameter state changes
     // parameterID: the ID of the parameter that changed
@@ -143,20 +315,100 @@ private:
     //==============================================================================
     struct LoopSlot
     {
-        juce::AudioBuffer<float> buffer;
-        std::atomic<int> length { 0 };
+        juce::AudioBuffer<StorageType> buffer;
+        // Held while another thread reads buffer's channel pointers and size. The audio thread
+        // only swaps buffer (capture, and taking a full-size one back) if it can take this.
+        std::atomic<bool> bufferInUse { false };
+        // The take is the audio recorded into buffer; the loop is the part of it that plays,
+        // between its start and end markers. Every kernel reads relative to loopStart, so
+        // moving the markers (trim, slide, halve) never touches the audio.
+        std::atomic<int> takeStart { 0 };
+        std::atomic<int> takeLength { 0 };
+        std::atomic<int> loopStart { 0 };
+        std::atomic<int> length { 0 };      // End marker - start marker
         std::atomic<bool> hasContent { false };
         std::atomic<bool> isRecording { false };
         std::atomic<bool> isPlaying { false };
-        std::atomic<float> playPosition { 0.0f };
-        std::atomic<float> recordPosition { 0.0f };
-        float fadeInGain = 1.0f;
-        float fadeOutGain = 1.0f;
+        // Double so the playhead stays sample-exact on long loops over long sessions
+        std::atomic<double> playPosition { 0.0 };
+        std::atomic<double> recordPosition { 0.0 };
+
+        // Punch fades for overdubbing: the input (and the stack attenuation) ramps in with
+        // fadeInGain after a punch-in, and out with fadeOutGain over a short tail after the
+        // punch-out. fadeOutGain > 0 while overdubbing or while that tail is still running.
+        std::atomic<float> fadeInGain { 1.0f };
+        std::atomic<float> fadeOutGain { 0.0f };
+
+        // Audio thread: the output gain (volume x slot level) the last block ended on, where
+        // the next block's gain ramp starts
+        float appliedGain = 1.0f;
+
+        // The span, in buffer positions, whose seam is faded on playback: a short fade-in at its
+        // start and fade-out at its end, repeating every span length so a multiplied loop's
+        // repeats are faded too. Only what's heard is faded - the stored audio never is, so
+        // markers widened again give the take back untouched. LoopTrimmer::Markers::pack(), 0 = none.
+        std::atomic<std::uint64_t> seamFade { 0 };
+
+        // Marker moves, applied at the next seam. takeRevision changes whenever the audio does
+        // (new take, capture, overdub); an auto-trim proposal is only applied to the
+        // revision it was scanned from, markers set by hand to any (anyRevision).
+        // crossedSeam: audio thread only, set when the playhead wrapped during the last chunk.
+        std::atomic<bool> trimRequested { false };
+        std::atomic<int> takeRevision { 0 };
+        std::atomic<int> pendingMarkersRevision { 0 };
+        std::atomic<std::uint64_t> pendingMarkers { 0 };  // LoopTrimmer::Markers::pack(), take-relative, 0 = none
+        bool crossedSeam = false;
+
+        // Multiply/divide requests, and the copy-on-write map of a multiplied take. The map is
+        // only used on the audio thread; pagesStale asks it to reset for a new take.
+        std::atomic<int> pendingMultiply { 0 };
+        std::atomic<int> pendingDivide { 0 };
+        std::atomic<bool> pagesStale { false };
+        LoopPages pages;
+
+        // Min/max pyramid of the buffer for the editor's waveform. Kept current block by block
+        // where the audio thread writes; overviewStale asks the loop worker to rebuild it
+        // after the buffer changed wholesale (capture, reset, synced padding).
+        WaveformOverview overview;
+        std::atomic<bool> overviewStale { false };
+
+        // Per-slot playback settings, kept when the slot is not the active one so
+        // each track plays back with its own direction/speed in multi-track mode
+        std::atomic<float> gain { 1.0f };
+        std::atomic<float> speed { 1.0f };
+        std::atomic<LoopMode> direction { LoopMode::Normal };
+
+        // Host sync: a loop recorded in sync is a whole number of beats long and started
+        // at syncAnchorPpq, so its playhead can be locked to the host position.
+        // syncLengthPpq == 0 means the loop is free-running.
+        std::atomic<double> syncAnchorPpq { 0.0 };
+        std::atomic<double> syncLengthPpq { 0.0 };
+        std::atomic<double> syncBpm { 0.0 };
+
+        // Overdub attenuation marker: the next loop sample to attenuate in the current pass.
+        // Only touched on the audio thread; startOverdubbing() marks it stale.
+        int overdubMarker = 0;
+        bool overdubMarkerReverse = false;
+        double overdubMarkerPosition = -1.0;  // Playhead where the last overdub block ended
+        // Soft limiter marker, trailing the writes: the first sample of the pass not limited
+        // yet (forward), or one past the last (reverse)
+        int limiterMarker = 0;
+        std::atomic<bool> overdubMarkerStale { true };
+    };
+
+    // Transport actions deferred to the next host bar/beat boundary
+    enum class SyncAction
+    {
+        None,
+        StopRecording,          // Stop recording and go idle
+        StopRecordingAndPlay,   // Stop recording and start playback
+        StartPlayback,
+        StopPlayback
     };
 
     //==============================================================================
-    static constexpr int maxLoopSlots = 4;
     static constexpr int maxLoopLengthSeconds = 240; // 4 minutes
+    static constexpr int anyRevision = -1;
 
     std::array<LoopSlot, maxLoopSlots> loopSlots;
     std::atomic<int> activeLoopSlot{0};
@@ -166,10 +418,25 @@ private:
     std::atomic<LooperState> currentState{LooperState::Stopped};
     std::atomic<LoopMode> loopMode{LoopMode::Normal};
     std::atomic<DirectionMode> currentDirection{DirectionMode::Forward};
+    std::atomic<LoopMode> recordDirection{LoopMode::Normal};  // Fixed for a take at startRecording()
     std::atomic<StackMode> stackMode{StackMode::Off};
     std::atomic<OnceMode> onceMode{OnceMode::Off};
     std::atomic<ThruMuteState> thruMute{ThruMuteState::Off};
     std::atomic<SpeedMode> speedMode{SpeedMode::Normal};
+    std::atomic<PlaybackMode> playbackMode{PlaybackMode::Single};
+    std::atomic<SyncMode> syncMode{SyncMode::Off};
+    std::atomic<bool> transportFollow{false};
+
+    // Host sync. The transport is written and read on the audio thread only; the button
+    // handlers see hostSyncAvailable and leave a pending action for the audio thread.
+    HostTransport hostTransport;
+    bool hostWasPlaying = false;  // Audio thread only, for transport start/stop edges
+    std::atomic<bool> hostSyncAvailable{false};
+    std::atomic<SyncAction> pendingSyncAction{SyncAction::None};
+    double syncActionPpq = -1.0;  // Boundary the pending action lands on, once the audio thread has seen it
+    static constexpr double phaseLockToleranceSamples = 1.0;
+    static constexpr double minTempoRatio = 0.5;  // Host/recorded tempo range a synced loop stretches over
+    static constexpr double maxTempoRatio = 2.0;
 
     double sampleRate = 44100.0;
     int samplesPerBlock = 512;
@@ -179,9 +446,122 @@ private:
     // Audio processing parameters (thread-safe)
     std::atomic<float> outputVolume { 1.0f };
     std::atomic<float> feedbackAmount { 0.5f };
+    float appliedFeedback = 0.5f;  // Audio thread: feedback the last block ended on
+
+    // Overdub decay settings, and the filter running through the current pass (audio thread)
+    std::atomic<float> overdubDecay { defaultOverdubDecay };
+    std::atomic<float> overdubTone { DecayFilter<StorageType>::maxToneHz };
+    DecayFilter<StorageType> decayFilter;
+    std::atomic<bool> softLimit { false };
+
+    // Meters the kernels add to as they go (audio thread), published once per host block
+    LevelMeter inputMeter;
+    LevelMeter loopMeter;
+    LevelMeter outputMeter;
+    MeterLevels currentMeterLevels;
+
+    // Written by the audio thread only, in publishStateSnapshot()
+    SeqLock<StateSnapshot> stateSnapshot;
+    std::uint32_t loopWrapCount = 0;
+
+    // Auto-start: Record arms, and processArmed() starts the take on the first loud sample
+    std::atomic<bool> autoStart { false };
+    std::atomic<bool> autoTrim { false };
+
+    // Continuous reverse: the head sweeps the loop and turns at each end (1 = up, -1 = down)
+    std::atomic<int> continuousReverseStep { 1 };
+
+    // Pre-roll ring for retroactive capture, twice the capture length. Every input sample is
+    // written twice, at captureWritePosition and captureWritePosition + capacity, so the most
+    // recent capacity samples are always contiguous. A capture swaps the ring's buffer with
+    // the slot's and points the slot's markers at that span; nothing is copied.
+    // There is only ever one ring-sized buffer: captureBufferOwner is the slot holding it
+    // (-1 = the ring itself), and that slot swaps back before it records a new take.
+    // The loop worker reallocates the ring when the length changes (resizedCaptureRing,
+    // handed over with captureRingResized); captureRingSamples tells it the current size.
+    std::atomic<int> captureSeconds { 0 };
+    std::atomic<bool> captureRequested { false };
+    juce::AudioBuffer<StorageType> captureRing;
+    int captureCapacity = 0;
+    int captureWritePosition = 0;
+    int captureFilled = 0;
+    int captureBufferOwner = -1;
+    std::atomic<int> captureRingSamples { 0 };    // -1 while a slot holds the ring-sized buffer
+    juce::AudioBuffer<StorageType> resizedCaptureRing;
+    std::atomic<bool> captureRingResized { false };
+
+    // This block's queued automation. After an event the next sub-block ends one fade
+    // length later, so the ramp to the new value is short whatever the host block size.
+    struct AutomationEvent
+    {
+        AutomatedParameter parameter;
+        int sampleOffset;
+        float value;
+    };
+
+    std::array<AutomationEvent, maxAutomationEvents> automationEvents {};
+    int numAutomationEvents = 0;
+    int nextAutomationEvent = 0;
+    int automationRampEnd = -1;
+    std::atomic<float> varispeed { 1.0f };  // Continuous playback speed, on top of Normal/Half
+
+    // Preallocated scratch for the block kernels (sized in prepare). The position tables
+    // are filled once per block and shared by every channel's inner loop.
+    juce::HeapBlock<int> blockIndex;
+    juce::HeapBlock<int> blockSource;  // Where each output sample's taps are stored, or -1 to read them one by one
+
+    // Variable-rate reader: precomputed sinc kernels, and the interpolated weights for each
+    // output sample of the block (numTaps per sample, first tap index in blockIndex)
+    SincTable sincTable;
+    juce::HeapBlock<float> blockWeights;
+
+    // Half-speed recording: 2:1 band-limited decimation of the input, and one channel's
+    // worth of decimated output. The reset flag is raised by startRecording() and
+    // consumed on the audio thread.
+    HalfbandDecimator<StorageType> recordDecimator;
+    juce::HeapBlock<StorageType> decimatedInput;
+    std::atomic<bool> recordDecimatorNeedsReset { true };
+
+    // Click-free edges: raised-cosine fade tables (fadeSamples long, sized in prepare) for the
+    // loop seam, and the ramp length for the overdub punch fades
+    static constexpr double fadeLengthSeconds = 0.001;
+    int fadeSamples = 44;
+    juce::HeapBlock<float> fadeInTable;
+    juce::HeapBlock<float> fadeOutTable;
+
+    // Pitch-preserving playback: one phase vocoder per slot, so multi-track slots keep
+    // their own frame history. The load measurer times each stretcher call.
+    std::atomic<bool> timeStretch { false };
+    std::array<TimeStretcher, maxLoopSlots> timeStretchers;
+    juce::AudioProcessLoadMeasurer timeStretchLoad;
+
+    // Per-precision block buffers: kernel scratch, plus the per-slot routed outputs for the
+    // chunk being processed. The routed outputs only refer to the caller's channel data;
+    // a slot with no active output is mixed into the main buffer.
+    template <typename SampleType>
+    struct BlockBuffers
+    {
+        juce::AudioBuffer<SampleType> scratch;
+        SlotOutputs<SampleType> routedOutputs;
+    };
+
+    BlockBuffers<float> floatBuffers;
+    BlockBuffers<double> doubleBuffers;
+
+    template <typename SampleType>
+    BlockBuffers<SampleType>& getBlockBuffers()
+    {
+        if constexpr (std::is_same_v<SampleType, double>)
+            return doubleBuffers;
+        else
+            return floatBuffers;
+    }
+
+    std::array<bool, maxLoopSlots> routedOutputActive {};
+    std::array<bool, maxLoopSlots> routedOutputWritten {};
 
     // Timing and synchronization
-    std::atomic<bool> loopWrapped{false};  // Set when loop cycles to position 0
+    std::atomic<bool> loopWrapped{false};  // Set when loop cycles to position 0, counted at the end of the block
     
     // Request flags for audio→UI thread communication (issue #38)
     // Audio thread sets these, UI timer processes them
@@ -193,9 +573,19 @@ private:
     // Callback for parameter state notifications to host
     ParameterNotifyCallback parameterNotifyCallback;
 
+    // Scans finished takes for silence, and rebuilds stale overviews, off the audio thread.
+    // Declared last so it's the first member destroyed, while the slots it reads still exist.
+    LoopTrimmer loopTrimmer { [this] { scanPendingTrims(); rebuildStaleOverviews(); resizeCaptureRing(); } };
+
     //==============================================================================
     void startRecording();
+    void armRecording();
+    void startOrArmRecording();
+    void cancelArmedRecording();
     void stopRecording();
+    void fillBuffer();
+    void startPlaybackAfterRecording();
+    void startContinuousReverse();
     void startPlayback();
     void stopPlayback();
     void startOverdubbing();
@@ -209,12 +599,123 @@ private:
     void toggleSpeedMode();
     void setSpeedMode(SpeedMode mode);
 
-    void processRecording(juce::AudioBuffer<float>& buffer, LoopSlot& slot);
-    void processPlayback(juce::AudioBuffer<float>& buffer, LoopSlot& slot);
-    void processOverdubbing(juce::AudioBuffer<float>& buffer, LoopSlot& slot);
+    // The kernels are templated on the host buffer's sample type (float or double)
+    template <typename SampleType> void processChunk(juce::AudioBuffer<SampleType>& buffer);
+    template <typename SampleType> void processArmed(juce::AudioBuffer<SampleType>& buffer, LoopSlot& slot);
+    template <typename SampleType> void processRecording(juce::AudioBuffer<SampleType>& buffer, LoopSlot& slot);
+    template <typename SampleType> void processPlayback(juce::AudioBuffer<SampleType>& buffer, LoopSlot& slot);
+    template <typename SampleType> void processOverdubbing(juce::AudioBuffer<SampleType>& buffer, LoopSlot& slot);
+    template <typename SampleType> void processContinuousReverse(juce::AudioBuffer<SampleType>& buffer, LoopSlot& slot);
+    template <typename SampleType> void processPlaybackFrom(juce::AudioBuffer<SampleType>& buffer, LoopSlot& slot, int startSample);
+    template <typename SampleType> void processMultiTrackPlayback(juce::AudioBuffer<SampleType>& buffer);
+
+    // First sample in the block over triggerThreshold on any channel, or -1
+    template <typename SampleType> int findOnset(const juce::AudioBuffer<SampleType>& buffer) const;
+
+    // Block kernels: read a slot into scratch, then sum it into the output
+    template <typename SampleType>
+    int readSlot(LoopSlot& slot, juce::AudioBuffer<SampleType>& dest, int numSamples, LoopMode direction, double rate);
+    // A playhead wrapping at the seam while the rate is back at exactly 1.0 lands on a whole
+    // sample, so readSlot() and the overdub return to their span paths. The seam fade hides the jump.
+    static double snapToWholeSampleAtUnity(double position, double rate, int slotLength) noexcept
+    {
+        if (rate != 1.0)
+            return position;
+
+        const double snapped = std::round(position);
+        return (snapped >= static_cast<double>(slotLength)) ? snapped - static_cast<double>(slotLength) : snapped;
+    }
+    template <typename SampleType>
+    void mixSlot(juce::AudioBuffer<SampleType>& output, const juce::AudioBuffer<SampleType>& source, int numSamples,
+                 float startGain, float endGain);
+
+    // A slot's peak and sum of squares, gathered lane by lane while its block is scaled
+    static constexpr int meterLanes = 8;
+
+    template <typename SampleType>
+    struct SlotMeter
+    {
+        SampleType peak[meterLanes] = {};
+        SampleType sumOfSquares[meterLanes] = {};
+    };
+
+    // Scales one channel of a slot's block by a gain ramp, into out (or added to it)
+    template <bool mixInto, typename SampleType>
+    static void scaleSlotChannel(SampleType* out, const SampleType* in, int numSamples, float startGain, float endGain,
+                                 SlotMeter<SampleType>& meter) noexcept;
+    template <typename SampleType>
+    void addToLoopMeter(const SlotMeter<SampleType>& meter, int numValues);
+    template <typename DestType, typename SourceType>
+    static void copySamples(DestType* dest, const SourceType* source, int numSamples);
+
+    // Routed slot outputs
+    template <typename SampleType> void bindSlotOutputs(SlotOutputs<SampleType>* slotOutputs, int startSample, int numSamples);
+    template <typename SampleType> void clearUnwrittenSlotOutputs();
+    template <typename SampleType> juce::AudioBuffer<SampleType>* getRoutedOutput(const LoopSlot& slot);
+    template <typename SampleType> void finishRoutedOutput(const LoopSlot& slot, int loopSamples, float startGain, float endGain);
+    template <typename SampleType>
+    static void mirrorFirstChannel(juce::AudioBuffer<SampleType>& output, int fromChannel, int numSamples);
+    int getSlotIndex(const LoopSlot& slot) const { return static_cast<int>(&slot - loopSlots.data()); }
+
+    // Host sync
+    bool canSyncToHost() const { return syncMode.load() != SyncMode::Off && hostSyncAvailable.load(); }
+    bool canFollowHost() const { return transportFollow.load() && hostSyncAvailable.load(); }
+    double getSamplesPerQuarterNote() const { return sampleRate * 60.0 / hostTransport.bpm; }
+    double getHostPpqAt(int sampleOffset) const { return hostTransport.ppqPosition + sampleOffset / getSamplesPerQuarterNote(); }
+    double getSyncUnitQuarterNotes() const;
+    void followHostTransport();
+    int getSyncActionOffset(int startSample, int numSamples);
+    bool isSyncActionValid(SyncAction action) const;
+    bool performSyncAction();   // False if a button press held the transition guard
+    void finishSyncedRecording(SyncAction action);
+    void lockSlotsToHost(int startSample);
+    double getTempoRatio(const LoopSlot& slot) const;
+    double getPlaybackRate(const LoopSlot& slot, float speed) const;
+
+    // Block-rate smoothing: returns the value the last block ended on, and makes target the next start
+    static float advanceRamp(float& applied, float target) noexcept { const float start = applied; applied = target; return start; }
+
+    template <typename SampleType> void writeCaptureRing(const juce::AudioBuffer<SampleType>& input);
+    void captureIntoActiveSlot(int startSample);
+    int getCaptureCapacity() const;
+    void takeResizedCaptureRing();
+    bool reclaimSlotBuffer(LoopSlot& slot);
+    void resizeCaptureRing();   // Trim worker thread
+    static StorageType* getLoopData(LoopSlot& slot, int channel) { return slot.buffer.getWritePointer(channel) + slot.loopStart.load(); }
+
+    void applyAutomationEvents(int startSample);
+    int getAutomationOffset(int startSample, int numSamples) const;
+    void finishAutomationEvents();
+    void publishStateSnapshot();
+
+    bool getSeamGains(const LoopSlot& slot, double startPosition, double step, int numSamples, float* gains) const;
+    template <typename SampleType>
+    void applySeamFade(const LoopSlot& slot, juce::AudioBuffer<SampleType>& dest, int channels, int numSamples, double startPosition, double step);
+    void scanPendingTrims();   // Trim worker thread
+    void rebuildStaleOverviews();   // Trim worker thread
+    // A slot buffer's channel pointers and size, read in one go
+    struct BufferView
+    {
+        std::array<const StorageType*, maxChannels> channels {};
+        int numChannels = 0;
+        int numSamples = 0;
+    };
 
-    bool advancePosition(std::atomic<float>& position, int length, float speed);
-    void switchToNextLoopSlot();
+    static BufferView getBufferView(const LoopSlot& slot);   // Audio thread, which does the swaps
+    static BufferView lockBufferView(LoopSlot& slot);        // Any other thread
+    void updateOverview(LoopSlot& slot, const BufferView& view, int from, int to, int validFrom, int validTo);
+    void updateLoopOverview(LoopSlot& slot, int from, int numSamples);
+    void applyPendingMarkers();
+    void proposeLoopMarkers(LoopSlot& slot, int startSample, int endSample, int revision);
+    void multiplySlot(LoopSlot& slot, int factor);
+    bool multiplyBelow(LoopSlot& slot, int factor);
+    void divideSlot(LoopSlot& slot, int factor);
+    void materializeLoopRange(LoopSlot& slot, int from, int numSamples);
+    static std::array<StorageType*, maxChannels> getTakeData(LoopSlot& slot);   // Each channel's take start
+    int findNextEmptyLoopSlot() const;    // -1 once every slot holds a loop
+    void switchToLoopSlot(int slotIndex);
+    void restartAllSlots();
+    float getSpeedMultiplier() const { return (speedMode.load() == SpeedMode::Half) ? 0.5f : 1.0f; }
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LooperEngine)
 };
@@ -5,7 +5,7 @@
 
 //==============================================================================
 BoomerangAudioProcessorEditor::BoomerangAudioProcessorEditor (BoomerangAudioProcessor& p)
-    : AudioProcessorEditor (&p), audioProcessor (p), progressBar(progressValue)
+    : AudioProcessorEditor (&p), audioProcessor (p)
 {
     // Load background image from embedded binary data
     backgroundImage = juce::ImageCache::getFromMemory(BinaryData::boomerang_jpg, 
@@ -76,9 +76,6 @@ BoomerangAudioProcessorEditor::BoomerangAudioProcessorEditor (BoomerangAudioProc
     settingsButton.onClick = [this]() { showSettingsMenu(); };
     addAndMakeVisible(settingsButton);
 
-    // Setup progress bar
-    // addAndMakeVisible(progressBar);  // Hidden for now
-
     // Attach continuous controls to APVTS
     volumeAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
         audioProcessor.getAPVTS(), "volume", volumeSlider);
@@ -312,6 +309,12 @@ void BoomerangAudioProcessorEditor::paint (juce::Graphics& g)
         g.fillRect(thumbRect);
     }
     
+    if (showFooterBar)
+    {
+        drawLoopWaveform(g);
+        drawMeters(g);
+    }
+
     // Draw LEDs at top of device (scaled coordinates)
     float scale = getWidth() / 700.0f;
     int ledSize = static_cast<int>(10 * scale);
@@ -425,6 +428,12 @@ void BoomerangAudioProcessorEditor::resized()
         static_cast<int>(5 * scale)
     );
     
+    // The loop waveform sits behind the status text, with the meters to its right
+    waveformArea = controlsArea;
+    meterArea = waveformArea.removeFromRight(static_cast<int>(24 * scale));
+    waveformMins.resize(static_cast<size_t>(juce::jmax(0, waveformArea.getWidth())));
+    waveformMaxs.resize(waveformMins.size());
+
     // Status label - visible only when footer bar is shown
     statusLabel.setBounds(controlsArea);
     statusLabel.setFont(juce::Font(juce::FontOptions(12.0f * scale)));
@@ -446,64 +455,63 @@ void BoomerangAudioProcessorEditor::timerCallback()
     // Note: processAudioThreadRequests() is now called from processBlock (issue #51)
     // to ensure Once mode updates even when UI is closed
     
+    engineState = audioProcessor.getLooperEngine()->getStateSnapshot();
     updateStatusDisplay();
+
+    // The knob shows the volume the engine plays at, which a MIDI CC can move without
+    // touching the host parameter. No notification, so the attachment leaves it alone.
+    if (! volumeSlider.isMouseButtonDown())
+        volumeSlider.setValue(engineState.volume, juce::dontSendNotification);
     
     // Update progress bar
-    progressValue = audioProcessor.getLooperEngine()->getLoopProgress();
+    progressValue = engineState.loopProgress;
     
     // Update button toggle states to match engine state
-    auto thruState = audioProcessor.getLooperEngine()->getThruMuteState();
-    thruMuteButton.setToggleState(thruState == LooperEngine::ThruMuteState::On, juce::dontSendNotification);
-    
-    auto looperState = audioProcessor.getLooperEngine()->getState();
+    auto looperState = engineState.state;
     bool isRecording = (looperState == LooperEngine::LooperState::Recording || 
-                        looperState == LooperEngine::LooperState::Overdubbing);
+                        looperState == LooperEngine::LooperState::Overdubbing ||
+                        looperState == LooperEngine::LooperState::Armed ||
+                        looperState == LooperEngine::LooperState::ContinuousReverse);
     recordButton.setToggleState(isRecording, juce::dontSendNotification);
     
     bool isPlaying = (looperState == LooperEngine::LooperState::Playing || 
-                      looperState == LooperEngine::LooperState::Overdubbing);
+                      looperState == LooperEngine::LooperState::Overdubbing ||
+                      looperState == LooperEngine::LooperState::ContinuousReverse);
     playButton.setToggleState(isPlaying, juce::dontSendNotification);
     
-    auto loopMode = audioProcessor.getLooperEngine()->getLoopMode();
-    bool isReverse = (loopMode == LooperEngine::LoopMode::Reverse);
+    bool isReverse = (engineState.loopMode == LooperEngine::LoopMode::Reverse);
     reverseButton.setToggleState(isReverse, juce::dontSendNotification);
     
-    auto onceMode = audioProcessor.getLooperEngine()->getOnceMode();
-    bool isOnce = (onceMode == LooperEngine::OnceMode::On);
+    bool isOnce = (engineState.onceMode == LooperEngine::OnceMode::On);
     onceButton.setToggleState(isOnce, juce::dontSendNotification);
     
-    auto thruMuteState = audioProcessor.getLooperEngine()->getThruMuteState();
-    bool isThruMuted = (thruMuteState == LooperEngine::ThruMuteState::On);
+    bool isThruMuted = (engineState.thruMute == LooperEngine::ThruMuteState::On);
     thruMuteButton.setToggleState(isThruMuted, juce::dontSendNotification);
     
-    // Flash record button when loopCycle parameter is pulsed (issue #51)
-    // The Processor now handles detecting loop wraps and pulsing loopCycle
-    // We just read the parameter value to sync our visual flash
-    if (auto* loopCycleParam = audioProcessor.getAPVTS().getRawParameterValue(ParameterIDs::loopCycle))
+    // Flash record button when the loop wraps (issue #51). The snapshot counts wraps, so
+    // the flash follows the same wraps the processor pulses loopCycle for.
+    if (engineState.loopWraps != lastLoopWraps)
     {
-        bool loopCycleActive = loopCycleParam->load() >= 0.5f;
-        if (loopCycleActive && recordFlashCounter == 0)
-        {
-            recordFlashCounter = 5;  // Start flash for ~80ms (5 frames at 16ms)
-        }
-        else if (!loopCycleActive && recordFlashCounter > 0)
-        {
-            recordFlashCounter--;
-        }
+        lastLoopWraps = engineState.loopWraps;
+        recordFlashCounter = 5;  // Start flash for ~80ms (5 frames at 16ms)
+    }
+    else if (recordFlashCounter > 0)
+    {
+        recordFlashCounter--;
     }
     
-    // Update LED states
-    recordLED = isRecording;
-    playLED = isPlaying;
-    onceLED = isOnce;
-    reverseLED = isReverse;
+    // Update LED states. Running out of memory lights every LED until Record or Play is pressed.
+    bool isBufferFilled = (looperState == LooperEngine::LooperState::BufferFilled);
+    recordLED = isRecording || isBufferFilled;
+    playLED = isPlaying || isBufferFilled;
+    onceLED = isOnce || isBufferFilled;
+    reverseLED = isReverse || isBufferFilled;
     
     // Stack LED: on when overdubbing (holding stack while playing)
-    stackLED = (looperState == LooperEngine::LooperState::Overdubbing);
+    stackLED = (looperState == LooperEngine::LooperState::Overdubbing) || isBufferFilled;
     
     // SLOW LED: on when speed mode is slow (half speed)
-    auto speedMode = audioProcessor.getLooperEngine()->getSpeedMode();
-    slowLED = (speedMode == LooperEngine::SpeedMode::Half);
+    slowLED = (engineState.speedMode == LooperEngine::SpeedMode::Half) || isBufferFilled;
     
     // Button release flash animation - track state changes
     auto updateButtonFlash = [](juce::TextButton& button, bool& prevDown, int& flashCounter) {
@@ -562,21 +570,85 @@ void BoomerangAudioProcessorEditor::drawLED(juce::Graphics& g, int x, int y, int
     }
 }
 
+void BoomerangAudioProcessorEditor::drawLoopWaveform(juce::Graphics& g)
+{
+    // Read from the engine's overview pyramid, so the cost is per column whatever the loop length
+    auto* engine = audioProcessor.getLooperEngine();
+    const int slotIndex = engineState.activeLoopSlot;
+    const int loopLength = engineState.loopLength;
+    const int columns = static_cast<int>(waveformMins.size());
+
+    if (loopLength <= 0 || columns == 0)
+        return;
+
+    engine->getLoopWaveform(slotIndex, 0, loopLength, columns, waveformMins.data(), waveformMaxs.data());
+
+    const float centreY = static_cast<float>(waveformArea.getCentreY());
+    const float halfHeight = static_cast<float>(waveformArea.getHeight()) * 0.5f;
+
+    g.setColour(juce::Colours::white.withAlpha(0.3f));
+
+    for (int column = 0; column < columns; ++column)
+    {
+        const float top = centreY - juce::jlimit(-1.0f, 1.0f, waveformMaxs[static_cast<size_t>(column)]) * halfHeight;
+        const float bottom = centreY - juce::jlimit(-1.0f, 1.0f, waveformMins[static_cast<size_t>(column)]) * halfHeight;
+        g.drawVerticalLine(waveformArea.getX() + column, top, juce::jmax(top + 1.0f, bottom));
+    }
+
+    // Playhead
+    const int playheadX = waveformArea.getX() + static_cast<int>(juce::jlimit(0.0, 1.0, progressValue) * (columns - 1));
+    g.setColour(juce::Colours::white.withAlpha(0.8f));
+    g.drawVerticalLine(playheadX, static_cast<float>(waveformArea.getY()), static_cast<float>(waveformArea.getBottom()));
+}
+
+void BoomerangAudioProcessorEditor::drawMeters(juce::Graphics& g)
+{
+    // One bar each for input, loop and output: RMS filled, peak as a line, -60 to 0 dBFS
+    const auto& meters = engineState.meters;
+    const LevelMeter::Level levels[] = { meters.input, meters.loop, meters.output };
+    const int barWidth = meterArea.getWidth() / 3;
+
+    auto toHeight = [this](float level)
+    {
+        const float decibels = juce::Decibels::gainToDecibels(level, -60.0f);
+        return juce::jlimit(0.0f, 1.0f, (decibels + 60.0f) / 60.0f) * static_cast<float>(meterArea.getHeight());
+    };
+
+    for (int meter = 0; meter < 3; ++meter)
+    {
+        const auto bar = meterArea.withX(meterArea.getX() + meter * barWidth).withWidth(juce::jmax(1, barWidth - 1)).toFloat();
+        const auto& level = levels[meter];
+        const juce::Colour colour = (level.peak >= 1.0f) ? juce::Colours::red : juce::Colours::green;
+
+        g.setColour(juce::Colours::black.withAlpha(0.3f));
+        g.fillRect(bar);
+
+        g.setColour(colour.withAlpha(0.7f));
+        g.fillRect(bar.withTop(bar.getBottom() - toHeight(level.rms)));
+
+        g.setColour(colour);
+        g.fillRect(bar.withTop(bar.getBottom() - toHeight(level.peak)).withHeight(1.0f));
+    }
+}
+
 void BoomerangAudioProcessorEditor::updateStatusDisplay()
 {
     juce::String statusText;
-    auto state = audioProcessor.getLooperEngine()->getState();
-    auto loopMode = audioProcessor.getLooperEngine()->getLoopMode();
-    auto once = audioProcessor.getLooperEngine()->getOnceMode();
-    auto stack = audioProcessor.getLooperEngine()->getStackMode();
-    auto speed = audioProcessor.getLooperEngine()->getSpeedMode();
-    auto thru = audioProcessor.getLooperEngine()->getThruMuteState();
+    auto state = engineState.state;
+    auto loopMode = engineState.loopMode;
+    auto once = engineState.onceMode;
+    auto stack = engineState.stackMode;
+    auto speed = engineState.speedMode;
+    auto thru = engineState.thruMute;
     
     switch (state)
     {
         case LooperEngine::LooperState::Stopped:
             statusText = "Stopped";
             break;
+        case LooperEngine::LooperState::Armed:
+            statusText = "Armed - Waiting for Input";
+            break;
         case LooperEngine::LooperState::Recording:
             statusText = "Recording";
             break;
@@ -611,6 +683,33 @@ void BoomerangAudioProcessorEditor::updateStatusDisplay()
 
     if (thru == LooperEngine::ThruMuteState::On)
         statusText += " [Thru Mute]";
+
+    statusText += " [Feedback " + juce::String(juce::roundToInt(engineState.feedback * 100.0f)) + "%]";
+
+    auto varispeed = engineState.varispeed;
+    if (varispeed != 1.0f)
+        statusText += " [Speed " + juce::String(varispeed, 2) + "x]";
+
+    if (engineState.timeStretching)
+        statusText += " [Keep Pitch " + juce::String(engineState.timeStretchLoad * 100.0, 1) + "% CPU]";
+
+    if (engineState.playbackMode == LooperEngine::PlaybackMode::MultiTrack)
+        statusText += " [Multi-Track: Loop " + juce::String(engineState.activeLoopSlot + 1) + "]";
+
+    auto sync = engineState.syncMode;
+    juce::String syncUnit = (sync == LooperEngine::SyncMode::Beats) ? "Beat" : "Bar";
+
+    if (sync != LooperEngine::SyncMode::Off)
+        statusText += " [Sync: " + syncUnit + "s]";
+
+    if (engineState.followingTransport)
+        statusText += " [Follow]";
+
+    if (engineState.captureSeconds > 0)
+        statusText += " [Capture " + juce::String(engineState.captureSeconds) + "s]";
+
+    if (engineState.waitingForSync)
+        statusText += " [Waiting for " + syncUnit + "]";
     
     statusLabel.setText(statusText, juce::dontSendNotification);
 }
@@ -620,6 +719,23 @@ void BoomerangAudioProcessorEditor::showSettingsMenu()
     
     menu.addItem(1, "Show Button Overlays", true, showButtonOverlays);
     menu.addItem(2, "Show Footer Bar",      true, showFooterBar);
+
+    // Host tempo sync (issue #20)
+    auto sync = audioProcessor.getLooperEngine()->getSyncMode();
+    juce::PopupMenu syncMenu;
+    syncMenu.addItem(10, "Off",   true, sync == LooperEngine::SyncMode::Off);
+    syncMenu.addItem(11, "Bars",  true, sync == LooperEngine::SyncMode::Bars);
+    syncMenu.addItem(12, "Beats", true, sync == LooperEngine::SyncMode::Beats);
+    menu.addSubMenu("Sync to Host", syncMenu);
+    menu.addItem(3, "Follow Host Transport", true, audioProcessor.getLooperEngine()->isFollowingTransport());
+    menu.addItem(4, "Keep Pitch at Other Speeds", true, audioProcessor.getLooperEngine()->isTimeStretching());
+    menu.addItem(5, "Capture Loop from Pre-Roll", audioProcessor.getLooperEngine()->getCaptureLength() > 0);
+    menu.addItem(6, "Auto-Start Recording on Input", true, audioProcessor.getLooperEngine()->isAutoStartEnabled());
+    menu.addItem(7, "Trim Silence from New Loops", true, audioProcessor.getLooperEngine()->isAutoTrimEnabled());
+    menu.addItem(8, "Multiply Loop (x2)");
+    menu.addItem(9, "Divide Loop (/2)");
+    menu.addItem(14, "Restore Untrimmed Loop");
+    menu.addItem(13, "Soft-Limit Overdubs", true, audioProcessor.getLooperEngine()->isSoftLimiting());
     
     menu.showMenuAsync(juce::PopupMenu::Options().withTargetComponent(&settingsButton),
         [this](int result) {
@@ -653,6 +769,48 @@ void BoomerangAudioProcessorEditor::showSettingsMenu()
                     }
                     break;
                 }
+                case 3:
+                    if (auto* followParam = audioProcessor.getAPVTS().getParameter(ParameterIDs::transportFollow))
+                        followParam->setValueNotifyingHost(audioProcessor.getLooperEngine()->isFollowingTransport() ? 0.0f : 1.0f);
+                    break;
+                case 4:
+                    if (auto* keepPitchParam = audioProcessor.getAPVTS().getParameter(ParameterIDs::keepPitch))
+                        keepPitchParam->setValueNotifyingHost(audioProcessor.getLooperEngine()->isTimeStretching() ? 0.0f : 1.0f);
+                    break;
+                case 5:
+                    if (auto* captureParam = audioProcessor.getAPVTS().getParameter(ParameterIDs::capture))
+                        captureParam->setValueNotifyingHost(captureParam->getValue() >= 0.5f ? 0.0f : 1.0f);
+                    break;
+                case 6:
+                    if (auto* autoStartParam = audioProcessor.getAPVTS().getParameter(ParameterIDs::autoStart))
+                        autoStartParam->setValueNotifyingHost(audioProcessor.getLooperEngine()->isAutoStartEnabled() ? 0.0f : 1.0f);
+                    break;
+                case 7:
+                    if (auto* autoTrimParam = audioProcessor.getAPVTS().getParameter(ParameterIDs::autoTrim))
+                        autoTrimParam->setValueNotifyingHost(audioProcessor.getLooperEngine()->isAutoTrimEnabled() ? 0.0f : 1.0f);
+                    break;
+                case 8:
+                    if (auto* multiplyParam = audioProcessor.getAPVTS().getParameter(ParameterIDs::multiply))
+                        multiplyParam->setValueNotifyingHost(multiplyParam->getValue() >= 0.5f ? 0.0f : 1.0f);
+                    break;
+                case 9:
+                    if (auto* divideParam = audioProcessor.getAPVTS().getParameter(ParameterIDs::divide))
+                        divideParam->setValueNotifyingHost(divideParam->getValue() >= 0.5f ? 0.0f : 1.0f);
+                    break;
+                case 10:
+                case 11:
+                case 12:
+                    if (auto* syncParam = audioProcessor.getAPVTS().getParameter(ParameterIDs::sync))
+                        syncParam->setValueNotifyingHost(syncParam->convertTo0to1(static_cast<float>(result - 10)));
+                    break;
+                case 13:
+                    if (auto* softLimitParam = audioProcessor.getAPVTS().getParameter(ParameterIDs::softLimit))
+                        softLimitParam->setValueNotifyingHost(audioProcessor.getLooperEngine()->isSoftLimiting() ? 0.0f : 1.0f);
+                    break;
+                case 14:
+                    if (auto* restoreParam = audioProcessor.getAPVTS().getParameter(ParameterIDs::restoreLoop))
+                        restoreParam->setValueNotifyingHost(restoreParam->getValue() >= 0.5f ? 0.0f : 1.0f);
+                    break;
                 default:
                     break;
             }
@@ -45,9 +45,19 @@ private:
     
     juce::TextButton settingsButton;  // Gear icon for settings menu
 
-    // Progress indicator
-    juce::ProgressBar progressBar;
+    // Playhead, and the active loop's waveform drawn across the footer (one column per pixel)
     double progressValue = 0.0;
+    juce::Rectangle<int> waveformArea;
+    std::vector<float> waveformMins;
+    std::vector<float> waveformMaxs;
+
+    // Input, loop and output meters at the right of the footer
+    juce::Rectangle<int> meterArea;
+
+    // Engine state as of the last block, read once per timer tick so every LED, label and
+    // meter drawn in a frame agrees
+    LooperEngine::StateSnapshot engineState;
+    std::uint32_t lastLoopWraps = 0;
     
     // Background image
     juce::Image backgroundImage;
@@ -95,6 +105,8 @@ private:
     void setupButton(juce::TextButton& button, const juce::String& text, juce::Colour colour, bool isToggle = false);
     void updateStatusDisplay();
     void drawLED(juce::Graphics& g, int x, int y, int size, juce::Colour colour, bool isLit);
+    void drawLoopWaveform(juce::Graphics& g);
+    void drawMeters(juce::Graphics& g);
     void showSettingsMenu();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BoomerangAudioProcessorEditor)
@@ -69,20 +69,175 @@ juce::AudioProcessorValueTreeState::ParameterLayout BoomerangAudioProcessor::cre
         juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f),
         0.5f));
 
+    // Tape-style decay - each overdub pass turns the loop under it down and darkens it
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID(ParameterIDs::decay, 1),
+        "Overdub Decay",
+        juce::NormalisableRange<float>(LooperEngine::minOverdubDecay, 0.0f, 0.1f),
+        LooperEngine::defaultOverdubDecay));
+
+    juce::NormalisableRange<float> toneRange(500.0f, DecayFilter<float>::maxToneHz);
+    toneRange.setSkewForCentre(3000.0f);
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID(ParameterIDs::tone, 1),
+        "Overdub Tone",
+        toneRange,
+        DecayFilter<float>::maxToneHz));
+
+    // Soft limit - stacked overdubs saturate toward full scale instead of building past it
+    layout.add(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID(ParameterIDs::softLimit, 1),
+        "Soft Limit",
+        false));  // toggle
+
+    // Auto-start - Record waits for input over the trigger threshold before recording
+    layout.add(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID(ParameterIDs::autoStart, 1),
+        "Auto-Start Recording",
+        false));  // toggle
+
+    // Auto-trim - a finished take's silent head and tail are dropped in the background
+    layout.add(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID(ParameterIDs::autoTrim, 1),
+        "Trim Silence",
+        false));  // toggle
+
+    // Multiply/divide - double or halve the active loop on each press
+    layout.add(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID(ParameterIDs::multiply, 1),
+        "Multiply",
+        false));  // momentary button
+
+    layout.add(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID(ParameterIDs::divide, 1),
+        "Divide",
+        false));  // momentary button
+
+    // Undo a trim or divide: the take's audio is all still there
+    layout.add(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID(ParameterIDs::restoreLoop, 1),
+        "Restore Loop",
+        false));  // momentary button
+
+    // Retroactive capture - the input is always kept for this many seconds, and Capture
+    // turns it into a loop (the last whole bars/beats when synced)
+    layout.add(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID(ParameterIDs::capture, 1),
+        "Capture",
+        false));  // momentary button
+
+    layout.add(std::make_unique<juce::AudioParameterInt>(
+        juce::ParameterID(ParameterIDs::captureLength, 1),
+        "Capture Length",
+        0, LooperEngine::maxCaptureSeconds, 0));
+
+    // MIDI CCs read at their exact sample position for volume and feedback (0 = off). Off by
+    // default so they don't clash with CCs the host maps to the buttons.
+    layout.add(std::make_unique<juce::AudioParameterInt>(
+        juce::ParameterID(ParameterIDs::volumeCC, 1),
+        "Volume CC",
+        0, 127, 0));
+
+    layout.add(std::make_unique<juce::AudioParameterInt>(
+        juce::ParameterID(ParameterIDs::feedbackCC, 1),
+        "Feedback CC",
+        0, 127, 0));
+
+    // Varispeed - continuous playback speed on top of Normal/Half, 1x at the centre
+    juce::NormalisableRange<float> speedRange(LooperEngine::minVarispeed, LooperEngine::maxVarispeed);
+    speedRange.setSkewForCentre(1.0f);
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID(ParameterIDs::speed, 1),
+        "Speed",
+        speedRange,
+        1.0f));
+
+    // Multi-track playback - all recorded slots play at once, each with its own level
+    layout.add(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID(ParameterIDs::multiTrack, 1),
+        "Multi-Track",
+        false));  // toggle
+
+    layout.add(std::make_unique<juce::AudioParameterInt>(
+        juce::ParameterID(ParameterIDs::loopSlot, 1),
+        "Loop Slot",
+        1, LooperEngine::maxLoopSlots, 1));
+
+    // Host tempo sync - quantizes record stop and loop length to the host's bars/beats
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID(ParameterIDs::sync, 1),
+        "Sync",
+        juce::StringArray { "Off", "Bars", "Beats" },
+        0));
+
+    // Follow the host transport - start/stop on the host's bar (or beat) boundaries
+    layout.add(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID(ParameterIDs::transportFollow, 1),
+        "Follow Transport",
+        false));  // toggle
+
+    // Keep pitch - half speed, varispeed and tempo sync change duration only
+    layout.add(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID(ParameterIDs::keepPitch, 1),
+        "Keep Pitch",
+        false));  // toggle
+
+    static_assert(std::size(ParameterIDs::loopLevel) == LooperEngine::maxLoopSlots,
+                  "One level parameter per loop slot");
+
+    for (int slot = 0; slot < LooperEngine::maxLoopSlots; ++slot)
+    {
+        layout.add(std::make_unique<juce::AudioParameterFloat>(
+            juce::ParameterID(ParameterIDs::loopLevel[slot], 1),
+            "Loop " + juce::String(slot + 1) + " Level",
+            juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f),
+            1.0f));
+    }
+
+    // Meters - peak levels for control surfaces to display. The plugin sets them, so the host
+    // is told they're read-only meters rather than automatable controls.
+    auto addMeter = [&layout](const juce::String& meterID, const juce::String& name, juce::AudioProcessorParameter::Category category)
+    {
+        layout.add(std::make_unique<juce::AudioParameterFloat>(
+            juce::ParameterID(meterID, 1),
+            name,
+            juce::NormalisableRange<float>(minMeterDecibels, maxMeterDecibels),
+            minMeterDecibels,
+            juce::AudioParameterFloatAttributes().withLabel("dB")
+                                                 .withAutomatable(false)
+                                                 .withCategory(category)));
+    };
+
+    addMeter(ParameterIDs::inputMeter, "Input Level", juce::AudioProcessorParameter::inputMeter);
+    addMeter(ParameterIDs::loopMeter, "Loop Level", juce::AudioProcessorParameter::otherMeter);
+    addMeter(ParameterIDs::outputMeter, "Output Level", juce::AudioProcessorParameter::outputMeter);
+
     return layout;
 }
 
+juce::AudioProcessor::BusesProperties BoomerangAudioProcessor::createBusesProperties()
+{
+    BusesProperties properties;
+
+   #if ! JucePlugin_IsMidiEffect
+    #if ! JucePlugin_IsSynth
+    properties = properties.withInput  ("Input",  juce::AudioChannelSet::stereo(), true);
+    #endif
+    properties = properties.withOutput ("Output", juce::AudioChannelSet::stereo(), true);
+
+    // Optional per-slot outputs so the host can process each loop separately.
+    // Disabled by default - a disabled bus has no channels and costs nothing.
+    for (int slot = 0; slot < LooperEngine::maxLoopSlots; ++slot)
+        properties = properties.withOutput ("Loop " + juce::String (slot + 1), juce::AudioChannelSet::stereo(), false);
+   #endif
+
+    return properties;
+}
+
 //==============================================================================
 BoomerangAudioProcessor::BoomerangAudioProcessor()
 #ifndef JucePlugin_PreferredChannelConfigurations
-     : AudioProcessor (BusesProperties()
-                     #if ! JucePlugin_IsMidiEffect
-                      #if ! JucePlugin_IsSynth
-                       .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
-                      #endif
-                       .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
-                     #endif
-                       ),
+     : AudioProcessor (createBusesProperties()),
        apvts(*this, nullptr, "Parameters", createParameterLayout())
 #endif
 {
@@ -122,10 +277,26 @@ BoomerangAudioProcessor::BoomerangAudioProcessor()
     apvts.addParameterListener(ParameterIDs::once, this);
     apvts.addParameterListener(ParameterIDs::stack, this);
     apvts.addParameterListener(ParameterIDs::reverse, this);
+    apvts.addParameterListener(ParameterIDs::multiTrack, this);
+    apvts.addParameterListener(ParameterIDs::loopSlot, this);
+    apvts.addParameterListener(ParameterIDs::sync, this);
+    apvts.addParameterListener(ParameterIDs::transportFollow, this);
+    apvts.addParameterListener(ParameterIDs::keepPitch, this);
+    apvts.addParameterListener(ParameterIDs::capture, this);
+    apvts.addParameterListener(ParameterIDs::autoStart, this);
+    apvts.addParameterListener(ParameterIDs::autoTrim, this);
+    apvts.addParameterListener(ParameterIDs::softLimit, this);
+    apvts.addParameterListener(ParameterIDs::multiply, this);
+    apvts.addParameterListener(ParameterIDs::divide, this);
+    apvts.addParameterListener(ParameterIDs::restoreLoop, this);
+
+    startTimerHz(meterRefreshHz);
 }
 
 BoomerangAudioProcessor::~BoomerangAudioProcessor()
 {
+    stopTimer();
+
     // Remove parameter listeners
     apvts.removeParameterListener(ParameterIDs::thruMute, this);
     apvts.removeParameterListener(ParameterIDs::record, this);
@@ -133,6 +304,41 @@ BoomerangAudioProcessor::~BoomerangAudioProcessor()
     apvts.removeParameterListener(ParameterIDs::once, this);
     apvts.removeParameterListener(ParameterIDs::stack, this);
     apvts.removeParameterListener(ParameterIDs::reverse, this);
+    apvts.removeParameterListener(ParameterIDs::multiTrack, this);
+    apvts.removeParameterListener(ParameterIDs::loopSlot, this);
+    apvts.removeParameterListener(ParameterIDs::sync, this);
+    apvts.removeParameterListener(ParameterIDs::transportFollow, this);
+    apvts.removeParameterListener(ParameterIDs::keepPitch, this);
+    apvts.removeParameterListener(ParameterIDs::capture, this);
+    apvts.removeParameterListener(ParameterIDs::autoStart, this);
+    apvts.removeParameterListener(ParameterIDs::autoTrim, this);
+    apvts.removeParameterListener(ParameterIDs::softLimit, this);
+    apvts.removeParameterListener(ParameterIDs::multiply, this);
+    apvts.removeParameterListener(ParameterIDs::divide, this);
+    apvts.removeParameterListener(ParameterIDs::restoreLoop, this);
+}
+
+//==============================================================================
+void BoomerangAudioProcessor::timerCallback()
+{
+    // One snapshot, so all three meters come from the same block. Only changes go to the
+    // host, and meters aren't listened to, so this never reaches parameterChanged().
+    const auto levels = looperEngine->getMeterLevels();
+
+    auto publish = [this](const juce::String& meterID, float peak)
+    {
+        if (auto* param = apvts.getParameter(meterID))
+        {
+            const float normalizedValue = param->convertTo0to1(juce::Decibels::gainToDecibels(peak, minMeterDecibels));
+
+            if (std::abs(normalizedValue - param->getValue()) > 0.001f)
+                param->setValueNotifyingHost(normalizedValue);
+        }
+    };
+
+    publish(ParameterIDs::inputMeter, levels.input.peak);
+    publish(ParameterIDs::loopMeter, levels.loop.peak);
+    publish(ParameterIDs::outputMeter, levels.output.peak);
 }
 
 //==============================================================================
@@ -169,6 +375,22 @@ void BoomerangAudioProcessor::parameterChanged(const juce::String& parameterID,
     {
         looperEngine->onPlayButtonPressed();
     }
+    else if (parameterID == ParameterIDs::capture)
+    {
+        looperEngine->onCaptureButtonPressed();
+    }
+    else if (parameterID == ParameterIDs::multiply)
+    {
+        looperEngine->multiplyLoop(2);
+    }
+    else if (parameterID == ParameterIDs::divide)
+    {
+        looperEngine->divideLoop(2);
+    }
+    else if (parameterID == ParameterIDs::restoreLoop)
+    {
+        looperEngine->restoreWholeTake();
+    }
     else if (parameterID == ParameterIDs::once)
     {
         if (buttonPressed)
@@ -186,6 +408,40 @@ void BoomerangAudioProcessor::parameterChanged(const juce::String& parameterID,
         else if (!buttonPressed && prevValue)
             looperEngine->onStackButtonReleased();
     }
+    // Multi-track settings
+    else if (parameterID == ParameterIDs::multiTrack)
+    {
+        looperEngine->setPlaybackMode(buttonPressed ? LooperEngine::PlaybackMode::MultiTrack
+                                                    : LooperEngine::PlaybackMode::Single);
+    }
+    else if (parameterID == ParameterIDs::loopSlot)
+    {
+        looperEngine->selectLoopSlot(juce::roundToInt(newValue) - 1);  // Parameter is 1-based
+    }
+    else if (parameterID == ParameterIDs::sync)
+    {
+        looperEngine->setSyncMode(static_cast<LooperEngine::SyncMode>(juce::roundToInt(newValue)));
+    }
+    else if (parameterID == ParameterIDs::transportFollow)
+    {
+        looperEngine->setTransportFollow(buttonPressed);
+    }
+    else if (parameterID == ParameterIDs::keepPitch)
+    {
+        looperEngine->setTimeStretch(buttonPressed);
+    }
+    else if (parameterID == ParameterIDs::autoStart)
+    {
+        looperEngine->setAutoStart(buttonPressed);
+    }
+    else if (parameterID == ParameterIDs::autoTrim)
+    {
+        looperEngine->setAutoTrim(buttonPressed);
+    }
+    else if (parameterID == ParameterIDs::softLimit)
+    {
+        looperEngine->setSoftLimit(buttonPressed);
+    }
 }
 
 //==============================================================================
@@ -255,10 +511,12 @@ void BoomerangAudioProcessor::changeProgramName (int index, const juce::String&
 //==============================================================================
 void BoomerangAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
-    // Use whichever is larger so we can still play back in stereo even if the host only
-    // provides a mono input (common with a single mic).
-    const int maxChannels = std::max(getTotalNumInputChannels(), getTotalNumOutputChannels());
-    looperEngine->prepare(sampleRate, samplesPerBlock, maxChannels);
+    // Loops are stored with the input's channel count: channel N records input N.
+    // A mono input stays a mono loop and is mirrored to the outputs after processing.
+    // Only the main bus is looped; the per-slot outputs mirror its layout.
+    const int inputChannels = getMainBusNumInputChannels();
+    const int loopChannels = (inputChannels > 0) ? inputChannels : getMainBusNumOutputChannels();
+    looperEngine->prepare(sampleRate, samplesPerBlock, juce::jlimit(1, LooperEngine::maxChannels, loopChannels));
 }
 
 void BoomerangAudioProcessor::releaseResources()
@@ -276,38 +534,52 @@ bool BoomerangAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts
     const auto& outSet = layouts.getMainOutputChannelSet();
     const auto& inSet  = layouts.getMainInputChannelSet();
 
-    // Allow mono or stereo output only
-    if (outSet != juce::AudioChannelSet::mono() && outSet != juce::AudioChannelSet::stereo())
+    // Any discrete layout up to the engine's channel limit
+    if (outSet.isDisabled() || outSet.size() > LooperEngine::maxChannels)
         return false;
 
     #if ! JucePlugin_IsSynth
-    // Permit mono-in→stereo-out or matching mono/mono, stereo/stereo.
-    const bool inputIsMonoOrStereo = (inSet == juce::AudioChannelSet::mono() || inSet == juce::AudioChannelSet::stereo());
-    if (! inputIsMonoOrStereo)
-        return false;
-
-    // NOTE: We don't currently support stereo-in → mono-out because the engine assumes
-    // output channels >= input channels. If we add downmixing, we can relax this.
-    const bool matches = (inSet == outSet) || (inSet == juce::AudioChannelSet::mono() && outSet == juce::AudioChannelSet::stereo());
-    if (! matches)
+    // Input must match the output width, or be mono (mirrored to every output channel).
+    // We don't downmix, so a wider input than output is rejected.
+    if (inSet != outSet && inSet != juce::AudioChannelSet::mono())
         return false;
     #endif
 
+    // Per-slot outputs are optional; when enabled they must match the main output
+    for (int bus = 1; bus <= LooperEngine::maxLoopSlots; ++bus)
+    {
+        const auto slotSet = layouts.getChannelSet (false, bus);
+        if (! slotSet.isDisabled() && slotSet != outSet)
+            return false;
+    }
+
     return true;
   #endif
 }
 #endif
 
 void BoomerangAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+    processSamples (buffer, midiMessages);
+}
+
+void BoomerangAudioProcessor::processBlock (juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
+{
+    // 64-bit hosts get their buffer processed natively, without a float round trip
+    processSamples (buffer, midiMessages);
+}
+
+template <typename SampleType>
+void BoomerangAudioProcessor::processSamples (juce::AudioBuffer<SampleType>& buffer, juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
-    juce::ignoreUnused(midiMessages);
 
-    auto totalNumInputChannels  = getTotalNumInputChannels();
-    auto totalNumOutputChannels = getTotalNumOutputChannels();
+    auto mainNumInputChannels  = getMainBusNumInputChannels();
+    auto mainNumOutputChannels = getMainBusNumOutputChannels();
 
-    // Clear any unused output channels
-    for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
+    // Clear any unused main output channels. The per-slot buses are always
+    // fully written (or cleared) by the looper engine.
+    for (auto i = mainNumInputChannels; i < mainNumOutputChannels; ++i)
         buffer.clear (i, 0, buffer.getNumSamples());
 
     // Safety check
@@ -317,27 +589,124 @@ void BoomerangAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, ju
         return;
     }
 
-    // Update continuous parameters from APVTS (thread-safe)
+    // Update continuous parameters from APVTS (thread-safe). Volume and feedback are only
+    // pushed when they change, so a value set by a MIDI CC event holds until they do.
     if (auto* volumeParam = apvts.getRawParameterValue(ParameterIDs::volume))
     {
         float volumeValue = volumeParam->load();
-        if (!std::isnan(volumeValue) && !std::isinf(volumeValue))
+        if (!std::isnan(volumeValue) && !std::isinf(volumeValue) && volumeValue != lastVolumeValue)
+        {
             looperEngine->setVolume(volumeValue);
+            lastVolumeValue = volumeValue;
+        }
     }
     
     if (auto* feedbackParam = apvts.getRawParameterValue(ParameterIDs::feedback))
     {
         float feedbackValue = feedbackParam->load();
-        if (!std::isnan(feedbackValue) && !std::isinf(feedbackValue))
+        if (!std::isnan(feedbackValue) && !std::isinf(feedbackValue) && feedbackValue != lastFeedbackValue)
+        {
             looperEngine->setFeedback(feedbackValue);
+            lastFeedbackValue = feedbackValue;
+        }
+    }
+
+    // Sample-accurate volume/feedback from MIDI CC: the engine splits the block at each event
+    const int volumeController = juce::roundToInt(apvts.getRawParameterValue(ParameterIDs::volumeCC)->load());
+    const int feedbackController = juce::roundToInt(apvts.getRawParameterValue(ParameterIDs::feedbackCC)->load());
+
+    if (volumeController > 0 || feedbackController > 0)
+    {
+        for (const auto metadata : midiMessages)
+        {
+            const auto message = metadata.getMessage();
+
+            if (! message.isController())
+                continue;
+
+            const int controller = message.getControllerNumber();
+            const float value = static_cast<float>(message.getControllerValue()) / 127.0f;  // Both parameters are 0..1
+
+            if (controller == volumeController)
+                looperEngine->addAutomationEvent(LooperEngine::AutomatedParameter::Volume, metadata.samplePosition, value);
+            else if (controller == feedbackController)
+                looperEngine->addAutomationEvent(LooperEngine::AutomatedParameter::Feedback, metadata.samplePosition, value);
+        }
+    }
+
+    if (auto* speedParam = apvts.getRawParameterValue(ParameterIDs::speed))
+    {
+        float speedValue = speedParam->load();
+        if (!std::isnan(speedValue) && !std::isinf(speedValue))
+            looperEngine->setVarispeed(speedValue);
+    }
+
+    if (auto* captureLengthParam = apvts.getRawParameterValue(ParameterIDs::captureLength))
+        looperEngine->setCaptureLength(juce::roundToInt(captureLengthParam->load()));
+
+    if (auto* decayParam = apvts.getRawParameterValue(ParameterIDs::decay))
+        if (auto* toneParam = apvts.getRawParameterValue(ParameterIDs::tone))
+            looperEngine->setOverdubDecay(decayParam->load(), toneParam->load());
+
+    for (int slot = 0; slot < LooperEngine::maxLoopSlots; ++slot)
+    {
+        if (auto* levelParam = apvts.getRawParameterValue(ParameterIDs::loopLevel[slot]))
+        {
+            float levelValue = levelParam->load();
+            if (!std::isnan(levelValue) && !std::isinf(levelValue))
+                looperEngine->setSlotGain(slot, levelValue);
+        }
+    }
+
+    // Per-slot output buses (aux outputs 1..N). Disabled buses come back with no channels.
+    auto& slotOutputBuffers = getSlotOutputBuffers<SampleType>();
+
+    for (int slot = 0; slot < LooperEngine::maxLoopSlots; ++slot)
+    {
+        auto slotBus = getBusBuffer(buffer, false, slot + 1);
+        slotOutputBuffers[static_cast<size_t>(slot)].setDataToReferTo(slotBus.getArrayOfWritePointers(),
+                                                                      slotBus.getNumChannels(),
+                                                                      slotBus.getNumSamples());
+    }
+
+    // Host transport for tempo sync (issue #20). Without a playhead (e.g. standalone)
+    // the engine sees no tempo and records free-form.
+    LooperEngine::HostTransport transport;
+    if (auto* playHead = getPlayHead())
+    {
+        if (auto position = playHead->getPosition())
+        {
+            if (auto bpm = position->getBpm())
+            {
+                transport.hasTempo = (*bpm > 0.0);
+                transport.bpm = *bpm;
+            }
+
+            if (auto timeSig = position->getTimeSignature())
+            {
+                transport.numerator = timeSig->numerator;
+                transport.denominator = timeSig->denominator;
+            }
+
+            if (auto ppq = position->getPpqPosition())
+            {
+                transport.hasPpq = true;
+                transport.ppqPosition = *ppq;
+            }
+
+            transport.isPlaying = position->getIsPlaying();
+        }
     }
+    looperEngine->setHostTransport(transport);
 
     // Process audio through looper engine
-    looperEngine->processBlock(buffer);
+    auto mainBuffer = getBusBuffer(buffer, false, 0);
+    looperEngine->processBlock(mainBuffer, &slotOutputBuffers);
 
-    // Upmix mono input to stereo output so users with a single mic still hear both channels
-    if (totalNumInputChannels == 1 && totalNumOutputChannels >= 2)
-        buffer.copyFrom(1, 0, buffer, 0, 0, buffer.getNumSamples());
+    // Upmix mono input to every output channel so users with a single mic hear all of them
+    if (mainNumInputChannels == 1)
+        for (int channel = 1; channel < mainNumOutputChannels; ++channel)
+            mainBuffer.copyFrom(channel, 0, mainBuffer, 0, 0, mainBuffer.getNumSamples());
     
     // Process audio thread requests (issue #51 - ensures Once mode updates even when UI closed)
     // This handles shouldDisableOnce flag set by audio thread when loop wraps in Once mode
@@ -345,8 +714,12 @@ void BoomerangAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, ju
     
     // Pulse loopCycle parameter when loop wraps (issue #51)
     // This runs in processBlock so it works even when UI is closed
-    // Use peek (load) to check without clearing - the UI may also want to flash
-    if (looperEngine->checkAndClearLoopWrapped())
+    // The snapshot's wrap count is only read, so the UI sees the same wraps
+    const auto loopWraps = looperEngine->getStateSnapshot().loopWraps;
+    const bool loopWrapped = (loopWraps != lastLoopWraps);
+    lastLoopWraps = loopWraps;
+
+    if (loopWrapped)
     {
         // Start the pulse
         if (!loopCyclePulseActive.load())
@@ -408,6 +781,11 @@ void BoomerangAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
     // Save APVTS state - this automatically handles all parameters
     auto state = apvts.copyState();
+
+    // Except the meters, which are live readouts rather than settings
+    for (const auto& meterID : { ParameterIDs::inputMeter, ParameterIDs::loopMeter, ParameterIDs::outputMeter })
+        state.removeChild(state.getChildWithProperty("id", meterID), nullptr);
+
     std::unique_ptr<juce::XmlElement> xml(state.createXml());
     copyXmlToBinary(*xml, destData);
 }
@@ -429,6 +807,10 @@ void BoomerangAudioProcessor::setStateInformation (const void* data, int sizeInB
         onceParam->setValueNotifyingHost(0.0f);  // Once off
     if (auto* cycleParam = apvts.getParameter(ParameterIDs::loopCycle))
         cycleParam->setValueNotifyingHost(0.0f);  // No pulse
+
+    for (const auto& meterID : { ParameterIDs::inputMeter, ParameterIDs::loopMeter, ParameterIDs::outputMeter })
+        if (auto* meterParam = apvts.getParameter(meterID))
+            meterParam->setValueNotifyingHost(0.0f);  // Silence, until the timer measures again
     
     // Reset engine to default state (Normal speed, Once off, etc.)
     looperEngine->resetTransientState();
@@ -17,9 +17,33 @@ namespace ParameterIDs
     const juce::String reverse    = "reverse";
     const juce::String volume     = "volume";
     const juce::String feedback   = "feedback";
+    const juce::String decay      = "decay";      // Loop gain per overdub pass, in dB
+    const juce::String tone       = "tone";       // Low-pass on the loop per overdub pass (max = off)
+    const juce::String softLimit  = "softLimit";  // Soft-limit overdubbed loop audio below full scale
+    const juce::String speed      = "speed";      // Continuous varispeed, 0.25x - 4x
     const juce::String loopCycle  = "loopCycle";  // Pulses when loop wraps (for REC blink)
     const juce::String slowMode   = "slowMode";   // On when speed is half (SLOW LED)
     const juce::String onceState  = "onceState"; // On when Once mode is active (ONCE LED)
+    const juce::String multiTrack = "multiTrack"; // Play all recorded loop slots together
+    const juce::String loopSlot   = "loopSlot";   // Active loop slot (1-based)
+    const juce::String sync       = "sync";       // Host tempo sync: Off / Bars / Beats
+    const juce::String transportFollow = "transportFollow"; // Start/stop with the host transport
+    const juce::String keepPitch  = "keepPitch";  // Time-stretch instead of resampling at non-unity speed
+    const juce::String volumeCC   = "volumeCC";   // MIDI CC for sample-accurate volume (0 = off)
+    const juce::String feedbackCC = "feedbackCC"; // MIDI CC for sample-accurate feedback (0 = off)
+    const juce::String capture    = "capture";    // Turn the pre-roll into a loop
+    const juce::String autoStart  = "autoStart";  // Record arms, and recording starts on input
+    const juce::String autoTrim   = "autoTrim";   // Drop silence at the head and tail of a take
+    const juce::String multiply   = "multiply";   // Double the loop length
+    const juce::String divide     = "divide";     // Halve the loop length
+    const juce::String restoreLoop = "restoreLoop"; // Widen the loop back out to its whole take
+    const juce::String captureLength = "captureLength"; // Pre-roll length in seconds (0 = off)
+    const juce::String inputMeter  = "inputMeter";  // Read-only: input peak level, dBFS
+    const juce::String loopMeter   = "loopMeter";   // Read-only: loop peak level, dBFS
+    const juce::String outputMeter = "outputMeter"; // Read-only: output peak level, dBFS
+
+    // Per-slot mix level, one per LooperEngine loop slot
+    const juce::String loopLevel[] = { "loopLevel1", "loopLevel2", "loopLevel3", "loopLevel4" };
 }
 
 //==============================================================================
@@ -33,7 +57,8 @@ namespace ParameterIDs
     or DAW automation, in addition to UI button clicks.
 */
 class BoomerangAudioProcessor : public juce::AudioProcessor,
-                                 private juce::AudioProcessorValueTreeState::Listener
+                                 private juce::AudioProcessorValueTreeState::Listener,
+                                 private juce::Timer
 {
 public:
     //==============================================================================
@@ -49,6 +74,8 @@ public:
    #endif
 
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock(juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override { return true; }
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -85,6 +112,9 @@ private:
     // AudioProcessorValueTreeState::Listener implementation
     void parameterChanged(const juce::String& parameterID, float newValue) override;
 
+    // Publishes the engine's meter levels to the read-only meter parameters (message thread)
+    void timerCallback() override;
+
     //==============================================================================
     // Core looper engine
     std::unique_ptr<LooperEngine> looperEngine;
@@ -103,9 +133,41 @@ private:
     std::atomic<bool> loopCyclePulseActive { false };
     std::atomic<int> loopCyclePulseCounter { 0 };
     static constexpr int loopCyclePulseDurationFrames = 5;  // ~80ms at 60Hz callback rate
+    std::uint32_t lastLoopWraps = 0;  // Audio thread: wrap count of the last block's snapshot
+
+    // Meter parameters: peak level in dBFS, refreshed at meterRefreshHz
+    static constexpr float minMeterDecibels = -60.0f;
+    static constexpr float maxMeterDecibels = 6.0f;
+    static constexpr int meterRefreshHz = 30;
+    
+    // Last volume/feedback parameter values pushed to the engine. Only changes are pushed,
+    // so a value set mid-block by MIDI CC isn't overwritten by a stale parameter.
+    float lastVolumeValue = -1.0f;
+    float lastFeedbackValue = -1.0f;
+
+    // Per-slot output bus views handed to the engine each block (refer to host channels, no copy),
+    // one set per host precision
+    LooperEngine::SlotOutputs<float> floatSlotOutputs;
+    LooperEngine::SlotOutputs<double> doubleSlotOutputs;
+
+    template <typename SampleType>
+    LooperEngine::SlotOutputs<SampleType>& getSlotOutputBuffers()
+    {
+        if constexpr (std::is_same_v<SampleType, double>)
+            return doubleSlotOutputs;
+        else
+            return floatSlotOutputs;
+    }
+
+    // Shared float/double processBlock body
+    template <typename SampleType>
+    void processSamples(juce::AudioBuffer<SampleType>& buffer, juce::MidiBuffer& midiMessages);
     
     // Helper function to create parameter layout
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+    // Helper function to create the bus layout (main in/out plus optional per-slot outputs)
+    static BusesProperties createBusesProperties();
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BoomerangAudioProcessor)
 };
\ No newline at end of file
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+//==============================================================================
+/**
+    Single-writer sequence lock for publishing a small struct from the audio thread
+
+    The writer never waits: it bumps the sequence to odd, stores the value word by word
+    and bumps it back to even. A reader copies the words out and retries if the sequence
+    was odd or moved while it read, so it always gets one coherent value, never a mix of
+    two writes. Retries only happen while a store is under way, which is a few stores long.
+
+    The value is kept as relaxed atomic words, so concurrent access is well defined.
+    Header-only, as it's a template over whatever is published.
+*/
+template <typename Value>
+class SeqLock
+{
+public:
+    //==============================================================================
+    static_assert(std::is_trivially_copyable_v<Value>, "Published values are copied word by word");
+
+    SeqLock() { store(Value {}); }
+
+    // Writer thread only
+    void store(const Value& value) noexcept
+    {
+        std::array<std::uint32_t, numWords> source {};
+        std::memcpy(source.data(), &value, sizeof(Value));
+
+        const auto sequenceBefore = sequence.load(std::memory_order_relaxed);
+        sequence.store(sequenceBefore + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for (size_t i = 0; i < numWords; ++i)
+            words[i].store(source[i], std::memory_order_relaxed);
+
+        sequence.store(sequenceBefore + 2, std::memory_order_release);
+    }
+
+    // Any thread
+    Value load() const noexcept
+    {
+        std::array<std::uint32_t, numWords> copy {};
+
+        for (;;)
+        {
+            const auto sequenceBefore = sequence.load(std::memory_order_acquire);
+
+            if ((sequenceBefore & 1u) != 0)
+                continue;
+
+            for (size_t i = 0; i < numWords; ++i)
+                copy[i] = words[i].load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (sequence.load(std::memory_order_relaxed) == sequenceBefore)
+                break;
+        }
+
+        Value value;
+        std::memcpy(static_cast<void*>(&value), copy.data(), sizeof(Value));
+        return value;
+    }
+
+private:
+    //==============================================================================
+    static constexpr size_t numWords = (sizeof(Value) + sizeof(std::uint32_t) - 1) / sizeof(std::uint32_t);
+
+    std::atomic<std::uint32_t> sequence { 0 };
+    std::array<std::atomic<std::uint32_t>, numWords> words {};
+
+    JUCE_DECLARE_NON_COPYABLE(SeqLock)
+};
@@ -0,0 +1,66 @@
+#include "SincTable.h"
+#include <cmath>
+
+//==============================================================================
+SincTable::SincTable()
+{
+    // Leave some transition band below Nyquist - 16 taps can't make a brick wall
+    constexpr double passband = 0.9;
+    const double halfWidth = numTaps / 2.0;
+
+    for (size_t band = 0; band < bands.size(); ++band)
+    {
+        const double cutoff = passband / bandMaxRates[band];
+        auto& table = bands[band];
+        table.resize(static_cast<size_t>((numPhases + 1) * numTaps));
+
+        for (int phase = 0; phase <= numPhases; ++phase)
+        {
+            const double fraction = static_cast<double>(phase) / numPhases;
+            float* row = table.data() + phase * numTaps;
+            double sum = 0.0;
+
+            for (int tap = 0; tap < numTaps; ++tap)
+            {
+                // Distance from the read position to this tap
+                const double x = static_cast<double>(tap - tapsBeforePosition) - fraction;
+                const double sinc = (x == 0.0) ? 1.0 : std::sin(juce::MathConstants<double>::pi * cutoff * x)
+                                                       / (juce::MathConstants<double>::pi * cutoff * x);
+
+                // Blackman-Harris window over [-halfWidth, halfWidth]
+                const double w = juce::MathConstants<double>::twoPi * (x + halfWidth) / (2.0 * halfWidth);
+                const double window = 0.35875 - 0.48829 * std::cos(w) + 0.14128 * std::cos(2.0 * w) - 0.01168 * std::cos(3.0 * w);
+
+                const double coefficient = cutoff * sinc * window;
+                row[tap] = static_cast<float>(coefficient);
+                sum += coefficient;
+            }
+
+            // Unity gain at DC for every phase, so slow sweeps don't ripple in level
+            for (int tap = 0; tap < numTaps; ++tap)
+                row[tap] = static_cast<float>(row[tap] / sum);
+        }
+    }
+}
+
+const float* SincTable::getBand(double rate) const
+{
+    for (size_t band = 0; band < bands.size(); ++band)
+        if (rate <= bandMaxRates[band])
+            return bands[band].data();
+
+    return bands.back().data();
+}
+
+void SincTable::computeWeights(const float* band, float fraction, float* weights) noexcept
+{
+    const float scaledPhase = fraction * static_cast<float>(numPhases);
+    const int phase = juce::jlimit(0, numPhases - 1, static_cast<int>(scaledPhase));
+    const float blend = scaledPhase - static_cast<float>(phase);
+
+    const float* row0 = band + phase * numTaps;
+    const float* row1 = row0 + numTaps;
+
+    for (int tap = 0; tap < numTaps; ++tap)
+        weights[tap] = row0[tap] + blend * (row1[tap] - row0[tap]);
+}
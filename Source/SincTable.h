@@ -0,0 +1,42 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <array>
+#include <vector>
+
+//==============================================================================
+/**
+    Precomputed windowed-sinc kernels for the looper's variable-rate reader
+
+    Each band is a polyphase table: numPhases + 1 rows of numTaps coefficients, one row
+    per fractional read position (the extra row lets the reader interpolate between
+    neighbouring phases). Reading faster than 1x shifts the loop's content up, so each
+    band lowers the cutoff to 1/rate to keep it from aliasing.
+
+    Built once on construction; lookups never allocate.
+*/
+class SincTable
+{
+public:
+    //==============================================================================
+    static constexpr int numTaps = 16;                     // Taps run from -7 to +8 around the read position
+    static constexpr int tapsBeforePosition = numTaps / 2 - 1;
+    static constexpr int numPhases = 256;
+
+    SincTable();
+
+    // Table for the band covering this playback rate (rates past the last band share it)
+    const float* getBand(double rate) const;
+
+    // Kernel for a fractional position in [0, 1), interpolated between the two nearest phases
+    static void computeWeights(const float* band, float fraction, float* weights) noexcept;
+
+private:
+    //==============================================================================
+    static constexpr int numBands = 7;
+    static constexpr std::array<double, numBands> bandMaxRates { 1.0, 1.5, 2.0, 3.0, 4.0, 6.0, 8.0 };
+
+    std::array<std::vector<float>, numBands> bands;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SincTable)
+};
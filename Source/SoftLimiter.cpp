@@ -0,0 +1,31 @@
+#include "SoftLimiter.h"
+#include <cmath>
+
+//==============================================================================
+template <typename SampleType>
+void SoftLimiter::process(SampleType* samples, int numSamples) noexcept
+{
+    const auto knee = static_cast<SampleType>(kneeLevel);
+    const auto range = static_cast<SampleType>(ceilingLevel - kneeLevel);
+    const auto rangeReciprocal = SampleType(1) / range;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const SampleType x = samples[i];
+        const SampleType level = std::abs(x);
+
+        // How far over the knee, scaled so tanh reaches the ceiling at 3
+        const SampleType over = juce::jmin(SampleType(3), juce::jmax(SampleType(0), level - knee) * rangeReciprocal);
+
+        // tanh(u) ~ u (27 + u^2) / (27 + 9 u^2): slope 1 at the knee, exactly 1 at u = 3
+        const SampleType overSquared = over * over;
+        const SampleType bent = over * (SampleType(27) + overSquared) / (SampleType(27) + SampleType(9) * overSquared);
+
+        const SampleType limited = juce::jmin(level, knee) + range * bent;
+        samples[i] = std::copysign(limited, x);
+    }
+}
+
+//==============================================================================
+template void SoftLimiter::process<float>(float*, int) noexcept;
+template void SoftLimiter::process<double>(double*, int) noexcept;
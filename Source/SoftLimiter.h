@@ -0,0 +1,27 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+//==============================================================================
+/**
+    Soft limiter for loop audio written back by an overdub
+
+    Samples below kneeLevel pass untouched; above it the level bends smoothly toward
+    ceilingLevel along a rational tanh approximation, so a loop stacked over many passes
+    saturates like tape instead of growing past full scale. The curve is branch-free, so
+    a span of samples is one vectorizable loop at the same cost whatever the level.
+*/
+class SoftLimiter
+{
+public:
+    //==============================================================================
+    static constexpr float kneeLevel = 0.7079458f;   // -3 dBFS: the headroom left linear
+    static constexpr float ceilingLevel = 1.0f;
+
+    // Limits numSamples in place
+    template <typename SampleType>
+    static void process(SampleType* samples, int numSamples) noexcept;
+
+private:
+    SoftLimiter() = delete;
+};
@@ -0,0 +1,224 @@
+#include "TimeStretcher.h"
+#include <cmath>
+
+//==============================================================================
+TimeStretcher::TimeStretcher()
+{
+    window.resize(static_cast<size_t>(frameSize));
+
+    for (int i = 0; i < frameSize; ++i)
+        window[static_cast<size_t>(i)] = 0.5f - 0.5f * std::cos(juce::MathConstants<float>::twoPi * static_cast<float>(i) / frameSize);
+}
+
+void TimeStretcher::prepare(int numChannels)
+{
+    frame.assign(static_cast<size_t>(2 * frameSize), 0.0f);
+    previousFrame.assign(static_cast<size_t>(2 * frameSize), 0.0f);
+    magnitudeScratch.assign(static_cast<size_t>(numBins), 0.0f);
+
+    channelStates.resize(static_cast<size_t>(numChannels));
+
+    for (auto& state : channelStates)
+    {
+        state.output.assign(static_cast<size_t>(frameSize), 0.0f);
+        state.phasor.assign(static_cast<size_t>(numBins), std::complex<float>(1.0f, 0.0f));
+    }
+
+    reset();
+}
+
+double TimeStretcher::wrapPosition(double position, int loopLength) const noexcept
+{
+    const double length = static_cast<double>(loopLength);
+    position = std::fmod(position, length);
+    return (position < 0.0) ? position + length : position;
+}
+
+//==============================================================================
+template <typename StorageType>
+void TimeStretcher::readFrame(const StorageType* source, int loopLength, int centre, int direction, PageMap pageMap, float* dest) const noexcept
+{
+    // Frames read in the playback direction, so reversed playback analyses reversed audio
+    int index = (centre - direction * (frameSize / 2)) % loopLength;
+    if (index < 0)
+        index += loopLength;
+
+    for (int i = 0; i < frameSize; ++i)
+    {
+        const int stored = (pageMap.pages != nullptr) ? pageMap.pages->resolve(pageMap.offset + index) - pageMap.offset : index;
+        dest[i] = window[static_cast<size_t>(i)] * static_cast<float>(source[stored]);
+
+        index += direction;
+        if (index >= loopLength)
+            index = 0;
+        else if (index < 0)
+            index = loopLength - 1;
+    }
+}
+
+template <typename StorageType>
+void TimeStretcher::addFrame(ChannelState& state, const StorageType* source, int loopLength,
+                             double centre, int direction, PageMap pageMap, bool firstFrame) noexcept
+{
+    const int centreIndex = static_cast<int>(std::floor(centre + 0.5));
+
+    // The frame at the playhead, and the one hopSize loop samples behind it: the phase
+    // difference between them is how far each bin turns over one synthesis hop
+    readFrame(source, loopLength, centreIndex, direction, pageMap, frame.data());
+    readFrame(source, loopLength, centreIndex - direction * hopSize, direction, pageMap, previousFrame.data());
+
+    fft.performRealOnlyForwardTransform(frame.data(), true);
+    fft.performRealOnlyForwardTransform(previousFrame.data(), true);
+
+    auto* bins = reinterpret_cast<std::complex<float>*>(frame.data());
+    const auto* previousBins = reinterpret_cast<const std::complex<float>*>(previousFrame.data());
+    auto* phasor = state.phasor.data();
+    float* magnitudes = magnitudeScratch.data();
+    constexpr float tiny = 1.0e-20f;
+
+    for (int bin = 0; bin < numBins; ++bin)
+        magnitudes[bin] = std::abs(bins[bin]);
+
+    // Identity phase locking: only spectral peaks get their phase advanced; the bins around
+    // each peak keep their analysed phase relative to it, so a partial spread over several
+    // bins stays coherent instead of beating against itself
+    int regionStart = 0;
+
+    while (regionStart < numBins)
+    {
+        // Find the next peak, then the trough after it that ends its region
+        int peak = regionStart;
+        while (peak + 1 < numBins && magnitudes[peak + 1] >= magnitudes[peak])
+            ++peak;
+
+        int regionEnd = peak + 1;
+        while (regionEnd < numBins && magnitudes[regionEnd] < magnitudes[regionEnd - 1])
+            ++regionEnd;
+
+        const std::complex<float> peakBin = bins[peak];
+        const float peakMagnitude = magnitudes[peak];
+
+        if (firstFrame)
+        {
+            // Start from the analysed phase so unity-rate output matches the loop
+            if (peakMagnitude > tiny)
+                phasor[peak] = peakBin / peakMagnitude;
+        }
+        else
+        {
+            const std::complex<float> advanced = phasor[peak] * peakBin * std::conj(previousBins[peak]);
+            const float advancedMagnitude = std::abs(advanced);
+
+            if (advancedMagnitude > tiny)
+                phasor[peak] = advanced / advancedMagnitude;
+        }
+
+        // Rotation from the peak's analysed phase to its synthesis phase, shared by its region
+        const std::complex<float> rotation = (peakMagnitude > tiny) ? phasor[peak] * std::conj(peakBin) / peakMagnitude
+                                                                    : phasor[peak];
+
+        for (int bin = regionStart; bin < regionEnd; ++bin)
+        {
+            if (bin != peak && magnitudes[bin] > tiny)
+                phasor[bin] = rotation * bins[bin] / magnitudes[bin];
+
+            bins[bin] = magnitudes[bin] * phasor[bin];
+        }
+
+        regionStart = regionEnd;
+    }
+
+    fft.performRealOnlyInverseTransform(frame.data());
+
+    // Hann analysis and synthesis windows at 4x overlap sum to 1.5
+    constexpr float overlapGain = 1.0f / 1.5f;
+    float* output = state.output.data();
+
+    for (int i = 0; i < frameSize; ++i)
+        output[i] += frame[static_cast<size_t>(i)] * window[static_cast<size_t>(i)] * overlapGain;
+}
+
+//==============================================================================
+template <typename StorageType, typename SampleType>
+void TimeStretcher::process(const juce::AudioBuffer<StorageType>& loop, int loopLength, double position, double step,
+                            juce::AudioBuffer<SampleType>& dest, int numChannels, int numSamples,
+                            const LoopPages* pages, int pageOffset)
+{
+    jassert(numChannels <= static_cast<int>(channelStates.size()));
+    jassert(loopLength > 0);
+
+    const int direction = (step < 0.0) ? -1 : 1;
+
+    // Small playhead nudges (host phase lock) keep the frame history; anything else restarts
+    double drift = position - expectedPosition;
+    if (std::abs(drift) > 0.5 * loopLength)
+        drift -= std::copysign(static_cast<double>(loopLength), drift);
+
+    if (std::abs(drift) > 16.0 || (step < 0.0) != (lastStep < 0.0))
+        needsPriming = true;
+
+    // A new frame is due whenever a hop has been used up. The frame added at output time t
+    // covers outputs t .. t + frameSize, so it's centred on where the playhead will be then.
+    auto shiftAndAddFrames = [&](double playhead, bool firstFrame)
+    {
+        const double centre = wrapPosition(playhead + step * (frameSize / 2), loopLength);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            auto& state = channelStates[static_cast<size_t>(channel)];
+            std::copy(state.output.begin() + hopSize, state.output.end(), state.output.begin());
+            std::fill(state.output.end() - hopSize, state.output.end(), 0.0f);
+
+            addFrame(state, loop.getReadPointer(channel), loopLength, centre, direction, { pages, pageOffset }, firstFrame);
+        }
+    };
+
+    if (needsPriming)
+    {
+        // Fill the overlap-add buffer with the frames that would have preceded this playhead
+        for (auto& state : channelStates)
+            std::fill(state.output.begin(), state.output.end(), 0.0f);
+
+        constexpr int overlap = frameSize / hopSize;
+
+        for (int frameIndex = overlap - 1; frameIndex >= 0; --frameIndex)
+            shiftAndAddFrames(position - step * (frameIndex * hopSize), frameIndex == overlap - 1);
+
+        hopPosition = 0;
+        needsPriming = false;
+    }
+
+    int done = 0;
+
+    while (done < numSamples)
+    {
+        if (hopPosition == hopSize)
+        {
+            shiftAndAddFrames(position + step * done, false);
+            hopPosition = 0;
+        }
+
+        const int span = juce::jmin(numSamples - done, hopSize - hopPosition);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            const float* output = channelStates[static_cast<size_t>(channel)].output.data() + hopPosition;
+            SampleType* out = dest.getWritePointer(channel, done);
+
+            for (int i = 0; i < span; ++i)
+                out[i] = static_cast<SampleType>(output[i]);
+        }
+
+        hopPosition += span;
+        done += span;
+    }
+
+    expectedPosition = wrapPosition(position + step * numSamples, loopLength);
+    lastStep = step;
+}
+
+//==============================================================================
+template void TimeStretcher::process<float, float>(const juce::AudioBuffer<float>&, int, double, double, juce::AudioBuffer<float>&, int, int, const LoopPages*, int);
+template void TimeStretcher::process<float, double>(const juce::AudioBuffer<float>&, int, double, double, juce::AudioBuffer<double>&, int, int, const LoopPages*, int);
+template void TimeStretcher::process<double, float>(const juce::AudioBuffer<double>&, int, double, double, juce::AudioBuffer<float>&, int, int, const LoopPages*, int);
+template void TimeStretcher::process<double, double>(const juce::AudioBuffer<double>&, int, double, double, juce::AudioBuffer<double>&, int, int, const LoopPages*, int);
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_dsp/juce_dsp.h>
+#include "LoopPages.h"
+#include <complex>
+#include <vector>
+
+//==============================================================================
+/**
+    Phase vocoder for pitch-preserving playback of a loop at any rate
+
+    The playhead moves through the loop at the playback rate as usual, but instead of
+    resampling, every hopSize output samples a frame is analysed around the playhead.
+    Its magnitudes are kept. Each spectral peak's phase advances by however far it moves
+    over hopSize loop samples, so the duration changes and the pitch doesn't, and the
+    bins around a peak follow it (identity phase locking).
+
+    The loop is stored in memory, so frames are read ahead of the playhead and there is
+    no added latency. FFT frames, windows and overlap-add buffers are allocated in
+    prepare(); process() never allocates.
+*/
+class TimeStretcher
+{
+public:
+    //==============================================================================
+    static constexpr int fftOrder = 11;
+    static constexpr int frameSize = 1 << fftOrder;  // 2048 samples
+    static constexpr int hopSize = frameSize / 4;    // 4x overlap
+    static constexpr int numBins = frameSize / 2 + 1;
+
+    TimeStretcher();
+
+    void prepare(int numChannels);
+
+    // Next process() restarts from its playhead instead of continuing the previous frames
+    void reset() { needsPriming = true; }
+
+    // Renders numSamples of the loop at the original pitch, starting at position and moving
+    // by step loop samples per output sample (negative when playing in reverse). A multiplied
+    // loop passes its page map, and the loop's offset into the take the map is relative to.
+    template <typename StorageType, typename SampleType>
+    void process(const juce::AudioBuffer<StorageType>& loop, int loopLength, double position, double step,
+                 juce::AudioBuffer<SampleType>& dest, int numChannels, int numSamples,
+                 const LoopPages* pages = nullptr, int pageOffset = 0);
+
+private:
+    //==============================================================================
+    struct ChannelState
+    {
+        std::vector<float> output;                 // Overlap-add accumulator, frameSize samples
+        std::vector<std::complex<float>> phasor;   // Unit-length synthesis phase per bin
+    };
+
+    struct PageMap
+    {
+        const LoopPages* pages;
+        int offset;
+    };
+
+    template <typename StorageType>
+    void readFrame(const StorageType* source, int loopLength, int centre, int direction, PageMap pageMap, float* frame) const noexcept;
+
+    template <typename StorageType>
+    void addFrame(ChannelState& state, const StorageType* source, int loopLength,
+                  double centre, int direction, PageMap pageMap, bool firstFrame) noexcept;
+
+    double wrapPosition(double position, int loopLength) const noexcept;
+
+    juce::dsp::FFT fft { fftOrder };
+    std::vector<float> window;         // Periodic Hann, used for analysis and synthesis
+    std::vector<float> frame;          // Real-only FFT buffers: 2 * frameSize floats
+    std::vector<float> previousFrame;
+    std::vector<float> magnitudeScratch;
+    std::vector<ChannelState> channelStates;
+
+    int hopPosition = 0;               // Output samples taken from the current hop
+    double expectedPosition = -1.0;    // Where the playhead should be on the next call
+    double lastStep = 0.0;
+    bool needsPriming = true;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TimeStretcher)
+};
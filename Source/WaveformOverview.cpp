@@ -0,0 +1,203 @@
+#include "WaveformOverview.h"
+
+//==============================================================================
+void WaveformOverview::prepare(int newNumSamples)
+{
+    numSamples = juce::jmax(0, newNumSamples);
+    numLevels = 0;
+    int total = 0;
+
+    // Halve until one bucket covers the whole buffer
+    for (int buckets = (numSamples + bucketSize - 1) / bucketSize; numLevels < maxLevels; buckets = (buckets + 1) / 2)
+    {
+        levels[static_cast<size_t>(numLevels++)] = { total, buckets };
+        total += buckets;
+
+        if (buckets <= 1)
+            break;
+    }
+
+    minimums.reset(new std::atomic<float>[static_cast<size_t>(total)]);
+    maximums.reset(new std::atomic<float>[static_cast<size_t>(total)]);
+
+    for (int i = 0; i < total; ++i)
+    {
+        minimums[i].store(0.0f);
+        maximums[i].store(0.0f);
+    }
+}
+
+void WaveformOverview::store(int level, int bucket, float minimum, float maximum) noexcept
+{
+    const int index = levels[static_cast<size_t>(level)].offset + bucket;
+    minimums[index].store(minimum);
+    maximums[index].store(maximum);
+}
+
+//==============================================================================
+template <typename SampleType>
+void WaveformOverview::update(const SampleType* const* channels, int numChannels, int from, int to, int validFrom, int validTo) noexcept
+{
+    from = juce::jmax(0, from);
+    to = juce::jmin(numSamples, to);
+
+    if (from >= to || numLevels == 0)
+        return;
+
+    const int firstBucket = from / bucketSize;
+    const int lastBucket = (to - 1) / bucketSize;
+
+    for (int bucket = firstBucket; bucket <= lastBucket; ++bucket)
+    {
+        const int start = juce::jmax(bucket * bucketSize, validFrom);
+        const int end = juce::jmin((bucket + 1) * bucketSize, validTo, numSamples);
+        auto range = juce::Range<SampleType>();
+
+        for (int channel = 0; channel < numChannels && start < end; ++channel)
+        {
+            const auto channelRange = juce::FloatVectorOperations::findMinAndMax(channels[channel] + start, end - start);
+            range = (channel == 0) ? channelRange : range.getUnionWith(channelRange);
+        }
+
+        store(0, bucket, static_cast<float>(range.getStart()), static_cast<float>(range.getEnd()));
+    }
+
+    updateLevels(from, to, validFrom, validTo);
+}
+
+void WaveformOverview::copyRepeats(int origin, int from, int to, int validFrom, int validTo) noexcept
+{
+    to = juce::jmin(numSamples, to);
+
+    if (origin < 0 || origin >= from || from >= to || numLevels == 0)
+        return;
+
+    const int period = from - origin;
+
+    // Each bucket takes the bucket its first repeated sample comes from. The one the take
+    // used to end in keeps its own audio as well.
+    for (int bucket = from / bucketSize; bucket <= (to - 1) / bucketSize; ++bucket)
+    {
+        const int position = juce::jmax(from, bucket * bucketSize);
+        const int source = (origin + (position - from) % period) / bucketSize;
+        float minimum = minimums[source].load();
+        float maximum = maximums[source].load();
+
+        if (bucket * bucketSize < from)
+        {
+            minimum = juce::jmin(minimum, minimums[bucket].load());
+            maximum = juce::jmax(maximum, maximums[bucket].load());
+        }
+
+        store(0, bucket, minimum, maximum);
+    }
+
+    updateLevels(from, to, validFrom, validTo);
+}
+
+void WaveformOverview::copyRepeatsBelow(int from, int origin, int end, int validFrom, int validTo) noexcept
+{
+    from = juce::jmax(0, from);
+
+    if (end > numSamples || origin >= end || from >= origin || numLevels == 0)
+        return;
+
+    const int period = end - origin;
+
+    // Mirrors copyRepeats(): the bucket the take used to start in keeps its own audio as well
+    for (int bucket = from / bucketSize; bucket <= (origin - 1) / bucketSize; ++bucket)
+    {
+        const int position = juce::jmax(from, bucket * bucketSize);
+        const int source = (origin + ((position - origin) % period + period) % period) / bucketSize;
+        float minimum = minimums[source].load();
+        float maximum = maximums[source].load();
+
+        if ((bucket + 1) * bucketSize > origin)
+        {
+            minimum = juce::jmin(minimum, minimums[bucket].load());
+            maximum = juce::jmax(maximum, maximums[bucket].load());
+        }
+
+        store(0, bucket, minimum, maximum);
+    }
+
+    updateLevels(from, origin, validFrom, validTo);
+}
+
+void WaveformOverview::updateLevels(int from, int to, int validFrom, int validTo) noexcept
+{
+    // Each parent is the union of its children that hold any valid audio
+    for (int level = 1; level < numLevels; ++level)
+    {
+        const auto& children = levels[static_cast<size_t>(level - 1)];
+        const int childSamples = getBucketSamples(level - 1);
+        const int samples = getBucketSamples(level);
+
+        for (int bucket = from / samples; bucket <= (to - 1) / samples; ++bucket)
+        {
+            float minimum = 0.0f;
+            float maximum = 0.0f;
+            bool any = false;
+
+            for (int child = bucket * 2; child < juce::jmin(bucket * 2 + 2, children.numBuckets); ++child)
+            {
+                if (child * childSamples >= validTo || (child + 1) * childSamples <= validFrom)
+                    continue;
+
+                const float childMinimum = minimums[children.offset + child].load();
+                const float childMaximum = maximums[children.offset + child].load();
+                minimum = any ? juce::jmin(minimum, childMinimum) : childMinimum;
+                maximum = any ? juce::jmax(maximum, childMaximum) : childMaximum;
+                any = true;
+            }
+
+            store(level, bucket, minimum, maximum);
+        }
+    }
+}
+
+//==============================================================================
+void WaveformOverview::read(int startSample, int numSamplesToRead, int numPoints, float* mins, float* maxs) const noexcept
+{
+    if (numPoints <= 0)
+        return;
+
+    if (numLevels == 0 || numSamplesToRead <= 0)
+    {
+        std::fill_n(mins, numPoints, 0.0f);
+        std::fill_n(maxs, numPoints, 0.0f);
+        return;
+    }
+
+    // The coarsest level whose buckets still fit in a column, so each column is a few buckets
+    const double columnSamples = static_cast<double>(numSamplesToRead) / numPoints;
+    int level = 0;
+    while (level + 1 < numLevels && getBucketSamples(level + 1) <= columnSamples)
+        ++level;
+
+    const auto& buckets = levels[static_cast<size_t>(level)];
+    const int samples = getBucketSamples(level);
+
+    for (int point = 0; point < numPoints; ++point)
+    {
+        const int start = startSample + static_cast<int>(point * columnSamples);
+        const int end = juce::jmax(start + 1, startSample + static_cast<int>((point + 1) * columnSamples));
+        const int firstBucket = juce::jlimit(0, buckets.numBuckets - 1, start / samples);
+        const int lastBucket = juce::jlimit(firstBucket, buckets.numBuckets - 1, (end - 1) / samples);
+        float minimum = minimums[buckets.offset + firstBucket].load();
+        float maximum = maximums[buckets.offset + firstBucket].load();
+
+        for (int bucket = firstBucket + 1; bucket <= lastBucket; ++bucket)
+        {
+            minimum = juce::jmin(minimum, minimums[buckets.offset + bucket].load());
+            maximum = juce::jmax(maximum, maximums[buckets.offset + bucket].load());
+        }
+
+        mins[point] = minimum;
+        maxs[point] = maximum;
+    }
+}
+
+//==============================================================================
+template void WaveformOverview::update<float>(const float* const*, int, int, int, int, int) noexcept;
+template void WaveformOverview::update<double>(const double* const*, int, int, int, int, int) noexcept;
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+
+//==============================================================================
+/**
+    Min/max pyramid of a slot's loop buffer, for drawing its waveform
+
+    Level 0 holds the minimum and maximum of every bucketSize samples of the buffer (all
+    channels together); each level above halves the resolution. The engine updates only
+    the buckets a block has written, so the pyramid stays current while recording and
+    overdubbing, and a view of any zoom is read in O(columns) without touching the audio.
+
+    Buckets are atomics: the audio thread (and the loop worker) write them, the message
+    thread reads them, and a view drawn mid-update is at worst one block out of date.
+    Samples outside the valid range an update is given (the current take) are left out,
+    so nothing left over from an earlier take shows through.
+*/
+class WaveformOverview
+{
+public:
+    //==============================================================================
+    static constexpr int bucketSize = 256;
+    static constexpr int maxLevels = 20;
+
+    WaveformOverview() = default;
+
+    // Allocates and clears the pyramid for a buffer of numSamples
+    void prepare(int numSamples);
+
+    // Recomputes the buckets overlapping [from, to) from the audio, counting only the samples
+    // in [validFrom, validTo), and the levels above them
+    template <typename SampleType>
+    void update(const SampleType* const* channels, int numChannels, int from, int to, int validFrom, int validTo) noexcept;
+
+    // The buckets over [from, to) take the values of those over [origin, from), which the
+    // audio there repeats (see LoopPages). Positions are buffer positions.
+    void copyRepeats(int origin, int from, int to, int validFrom, int validTo) noexcept;
+
+    // The same for repeats below the audio they repeat: [from, origin) takes [origin, end)'s
+    void copyRepeatsBelow(int from, int origin, int end, int validFrom, int validTo) noexcept;
+
+    // Any thread: the min and max of each of numPoints equal columns of [startSample, startSample + numSamples)
+    void read(int startSample, int numSamples, int numPoints, float* mins, float* maxs) const noexcept;
+
+private:
+    //==============================================================================
+    struct Level
+    {
+        int offset = 0;       // First bucket of the level in minimums/maximums
+        int numBuckets = 0;
+    };
+
+    int getBucketSamples(int level) const noexcept { return bucketSize << level; }
+    void updateLevels(int from, int to, int validFrom, int validTo) noexcept;
+    void store(int level, int bucket, float minimum, float maximum) noexcept;
+
+    std::unique_ptr<std::atomic<float>[]> minimums;
+    std::unique_ptr<std::atomic<float>[]> maximums;
+    std::array<Level, maxLevels> levels {};
+    int numLevels = 0;
+    int numSamples = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WaveformOverview)
+};
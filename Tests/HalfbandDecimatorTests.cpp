@@ -0,0 +1,82 @@
+#include "HalfbandDecimator.h"
+#include <cmath>
+#include <vector>
+
+//==============================================================================
+namespace
+{
+    constexpr int numInput = 4096;
+
+    // Amplitude of the decimated output for a cosine of freq (cycles per input sample),
+    // from its RMS once the filter's history has filled
+    double getGain(double freq)
+    {
+        HalfbandDecimator<float> decimator;
+        decimator.prepare(1, numInput);
+
+        std::vector<float> input(numInput), output(numInput);
+        for (int i = 0; i < numInput; ++i)
+            input[static_cast<size_t>(i)] = static_cast<float>(std::cos(juce::MathConstants<double>::twoPi * freq * i));
+
+        const int numOutput = decimator.process(0, input.data(), numInput, output.data());
+
+        double sumOfSquares = 0.0;
+        for (int i = numOutput / 4; i < numOutput; ++i)
+            sumOfSquares += output[static_cast<size_t>(i)] * output[static_cast<size_t>(i)];
+
+        const double meanSquare = sumOfSquares / (numOutput - numOutput / 4);
+        return std::sqrt(freq > 0.0 ? 2.0 * meanSquare : meanSquare);
+    }
+}
+
+//==============================================================================
+class HalfbandDecimatorTests : public juce::UnitTest
+{
+public:
+    HalfbandDecimatorTests() : juce::UnitTest("HalfbandDecimator", "Boomerang") {}
+
+    void runTest() override
+    {
+        beginTest("DC passes at unity gain");
+        expectWithinAbsoluteError(getGain(0.0), 1.0, 1.0e-3);
+
+        beginTest("The passband is flat");
+        {
+            for (double freq : { 0.02, 0.05, 0.1, 0.15 })
+                expectWithinAbsoluteError(getGain(freq), 1.0, 0.01);
+        }
+
+        beginTest("Half the output rate sits 3 dB down");
+        expectWithinAbsoluteError(getGain(0.25), std::sqrt(0.5), 0.01);
+
+        beginTest("What would alias is at least 60 dB down");
+        {
+            for (double freq : { 0.35, 0.4, 0.45, 0.49 })
+                expectLessThan(getGain(freq), 1.0e-3);
+        }
+
+        beginTest("Every second sample comes out, across blocks of any length");
+        {
+            HalfbandDecimator<float> decimator;
+            decimator.prepare(2, 64);
+
+            std::vector<float> input(64, 1.0f), output(64);
+            int totalInput = 0, totalOutput = 0;
+
+            for (int numSamples : { 7, 64, 1, 33, 2, 13 })
+            {
+                int numOutput = 0;
+                for (int channel = 0; channel < 2; ++channel)
+                    numOutput = decimator.process(channel, input.data(), numSamples, output.data());
+
+                decimator.advance(numSamples);
+                totalInput += numSamples;
+                totalOutput += numOutput;
+            }
+
+            expectEquals(totalOutput, totalInput / 2);
+        }
+    }
+};
+
+static HalfbandDecimatorTests halfbandDecimatorTests;
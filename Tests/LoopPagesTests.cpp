@@ -0,0 +1,214 @@
+#include "LoopPages.h"
+#include <random>
+#include <vector>
+
+//==============================================================================
+namespace
+{
+    constexpr int bufferSamples = 200000;
+
+    // A take in a buffer, multiplied and overdubbed at random through LoopPages, checked
+    // against a model that copies every repeat out in full
+    class PagedTake
+    {
+    public:
+        PagedTake(std::mt19937& randomToUse, bool downwards)
+            : random(randomToUse), growsDownwards(downwards), buffer(bufferSamples), model(bufferSamples)
+        {
+            pages.prepare(bufferSamples);
+
+            loopLength = 1000 + randomInt(20000);
+            takeStart = growsDownwards ? bufferSamples - loopLength - randomInt(500) : randomInt(500);
+            takeEnd = takeStart + loopLength;
+            loopStart = takeStart;
+
+            for (int p = takeStart; p < takeEnd; ++p)
+                buffer[static_cast<size_t>(p)] = model[static_cast<size_t>(p)] = static_cast<float>(p);
+        }
+
+        // Multiplies the loop by 2 to 4, if there's room and a level left for it
+        void multiply()
+        {
+            const int factor = 2 + randomInt(3);
+
+            if (growsDownwards)
+            {
+                const int newLoopStart = loopStart - loopLength * (factor - 1);
+                if (newLoopStart < 0)
+                    return;
+
+                const int newTakeStart = juce::jmin(takeStart, newLoopStart);
+                if (!pages.addRepeatsBelow(newLoopStart - newTakeStart, loopStart - newTakeStart,
+                                           loopStart + loopLength - newTakeStart, takeEnd - newTakeStart))
+                    return;
+
+                for (int p = newLoopStart; p < loopStart; ++p)
+                    model[static_cast<size_t>(p)] = model[static_cast<size_t>(loopStart + ((p - loopStart) % loopLength + loopLength) % loopLength)];
+
+                takeStart = newTakeStart;
+                loopStart = newLoopStart;
+            }
+            else
+            {
+                if (loopStart + loopLength * factor > bufferSamples
+                    || !pages.addRepeats(loopStart - takeStart, loopStart - takeStart + loopLength, loopStart - takeStart + loopLength * factor))
+                    return;
+
+                for (int p = loopStart + loopLength; p < loopStart + loopLength * factor; ++p)
+                    model[static_cast<size_t>(p)] = model[static_cast<size_t>(loopStart + (p - loopStart) % loopLength)];
+
+                takeEnd = loopStart + loopLength * factor;
+            }
+
+            loopLength *= factor;
+        }
+
+        // Writes new audio over a random span of the loop, as an overdub would
+        void overdub()
+        {
+            const int from = loopStart + randomInt(loopLength);
+            const int numSamples = juce::jmin(1 + randomInt(juce::jmin(loopLength, 9000)), loopStart + loopLength - from);
+
+            float* take = buffer.data() + takeStart;
+            pages.materialize(&take, 1, from - takeStart, numSamples);
+
+            for (int p = from; p < from + numSamples; ++p)
+                buffer[static_cast<size_t>(p)] = model[static_cast<size_t>(p)] = static_cast<float>(randomInt(100000)) + 0.5f;
+        }
+
+        // Every position reads the model's audio
+        bool readsModel() const
+        {
+            for (int p = takeStart; p < takeEnd; ++p)
+                if (buffer[static_cast<size_t>(takeStart + pages.resolve(p - takeStart))] != model[static_cast<size_t>(p)])
+                    return false;
+
+            return true;
+        }
+
+        // Runs reported from random positions resolve to consecutive storage
+        bool runsAreConsecutive()
+        {
+            for (int check = 0; check < 50; ++check)
+            {
+                const int position = takeStart + randomInt(takeEnd - takeStart);
+                const int direction = (random() % 2 == 0) ? 1 : -1;
+                const int runLength = pages.getRunLength(position - takeStart, direction);
+                const int stored = pages.resolve(position - takeStart);
+
+                if (runLength < 1)
+                    return false;
+
+                // A run may go on past the ends of the take, into storage the map doesn't cover
+                for (int i = 0; i < juce::jmin(runLength, 64); ++i)
+                {
+                    const int p = position + direction * i;
+                    if (p < takeStart || p >= takeEnd)
+                        break;
+
+                    if (pages.resolve(p - takeStart) != stored + direction * i)
+                        return false;
+                }
+            }
+
+            return true;
+        }
+
+    private:
+        int randomInt(int range) { return static_cast<int>(random() % static_cast<std::uint32_t>(range)); }
+
+        std::mt19937& random;
+        const bool growsDownwards;
+        std::vector<float> buffer, model;
+        LoopPages pages;
+        int takeStart = 0, takeEnd = 0, loopStart = 0, loopLength = 0;
+    };
+}
+
+//==============================================================================
+class LoopPagesTests : public juce::UnitTest
+{
+public:
+    LoopPagesTests() : juce::UnitTest("LoopPages", "Boomerang") {}
+
+    void runTest() override
+    {
+        beginTest("A plain take reads in place");
+        {
+            LoopPages pages;
+            pages.prepare(bufferSamples);
+
+            expect(pages.isIdentity());
+            expect(!pages.growsDownwards());
+            expectEquals(pages.resolve(12345), 12345);
+            expect(pages.isReal(12345));
+        }
+
+        beginTest("Repeats above resolve to the loop, until written");
+        {
+            LoopPages pages;
+            pages.prepare(bufferSamples);
+
+            // A 1000-sample loop at 500, tripled
+            expect(pages.addRepeats(500, 1500, 3500));
+            expect(!pages.isIdentity());
+            expectEquals(pages.resolve(1499), 1499);
+            expectEquals(pages.resolve(1500), 500);
+            expectEquals(pages.resolve(2750), 750);
+            expect(!pages.isReal(2750));
+            expect(!pages.addRepeatsBelow(0, 500, 1500, 3500));
+
+            std::vector<float> take(3500, 0.0f);
+            float* channels[] = { take.data() };
+            pages.materialize(channels, 1, 2700, 100);
+            expectEquals(pages.resolve(2750), 2750);
+            expect(pages.isReal(2750));
+        }
+
+        beginTest("Repeats below resolve to the loop");
+        {
+            LoopPages pages;
+            pages.prepare(bufferSamples);
+
+            // A 1000-sample loop at the top of a 3000-sample take, tripled downwards
+            expect(pages.addRepeatsBelow(0, 2000, 3000, 3000));
+            expect(pages.growsDownwards());
+            expectEquals(pages.resolve(2500), 2500);
+            expectEquals(pages.resolve(1999), 2999);
+            expectEquals(pages.resolve(1000), 2000);
+            expectEquals(pages.resolve(0), 2000);
+            expectEquals(pages.resolve(999), 2999);
+            expect(!pages.addRepeats(0, 3000, 6000));
+        }
+
+        for (const bool downwards : { false, true })
+        {
+            beginTest(downwards ? "Random multiplies and overdubs below match a copied model"
+                                : "Random multiplies and overdubs above match a copied model");
+
+            std::mt19937 random(downwards ? 2u : 1u);
+            int numMismatches = 0, numBadRuns = 0;
+
+            for (int trial = 0; trial < 100; ++trial)
+            {
+                PagedTake take(random, downwards);
+
+                for (int step = 0; step < 12; ++step)
+                {
+                    if (random() % 3 == 0)
+                        take.multiply();
+                    else
+                        take.overdub();
+
+                    numMismatches += take.readsModel() ? 0 : 1;
+                    numBadRuns += take.runsAreConsecutive() ? 0 : 1;
+                }
+            }
+
+            expectEquals(numMismatches, 0);
+            expectEquals(numBadRuns, 0);
+        }
+    }
+};
+
+static LoopPagesTests loopPagesTests;
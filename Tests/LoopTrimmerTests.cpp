@@ -0,0 +1,96 @@
+#include "LoopTrimmer.h"
+#include <cmath>
+#include <vector>
+
+//==============================================================================
+class LoopTrimmerTests : public juce::UnitTest
+{
+public:
+    LoopTrimmerTests() : juce::UnitTest("LoopTrimmer", "Boomerang") {}
+
+    void runTest() override
+    {
+        constexpr double sampleRate = 48000.0;
+        constexpr int numSamples = 48000;
+        const int attackMargin = juce::roundToInt(sampleRate * LoopTrimmer::attackMarginSeconds);
+        const int releaseMargin = juce::roundToInt(sampleRate * LoopTrimmer::releaseMarginSeconds);
+
+        std::vector<float> left(numSamples), right(numSamples);
+        const float* channels[] = { left.data(), right.data() };
+
+        beginTest("A silent take has no audible region");
+        {
+            expectEquals(LoopTrimmer::findAudibleRegion(channels, 2, numSamples, sampleRate).length, 0);
+
+            // Noise under the threshold is still silence
+            for (int i = 0; i < numSamples; ++i)
+                left[static_cast<size_t>(i)] = (i % 2 == 0) ? 0.0005f : -0.0005f;
+
+            expectEquals(LoopTrimmer::findAudibleRegion(channels, 2, numSamples, sampleRate).length, 0);
+        }
+
+        beginTest("Silence at both ends is trimmed, keeping the margins");
+        {
+            std::fill(left.begin(), left.end(), 0.0f);
+            constexpr int soundStart = 12000, soundEnd = 30000;
+
+            // On one channel only: any channel being loud makes the window loud
+            for (int i = soundStart; i < soundEnd; ++i)
+                right[static_cast<size_t>(i)] = 0.5f * static_cast<float>(std::sin(0.05 * i));
+
+            const auto markers = LoopTrimmer::findAudibleRegion(channels, 2, numSamples, sampleRate);
+            const int window = juce::roundToInt(sampleRate * LoopTrimmer::windowSeconds);
+
+            // Windows are scanned whole, so each edge lands within a window of the sound's
+            expectGreaterThan(markers.start, soundStart - attackMargin - window);
+            expectLessOrEqual(markers.start, soundStart - attackMargin);
+            expectGreaterOrEqual(markers.start + markers.length, soundEnd + releaseMargin);
+            expectLessThan(markers.start + markers.length, soundEnd + releaseMargin + window);
+        }
+
+        beginTest("Margins stop at the ends of the take");
+        {
+            std::fill(right.begin(), right.end(), 0.0f);
+            for (int i = 0; i < 100; ++i)
+                left[static_cast<size_t>(i)] = left[static_cast<size_t>(numSamples - 1 - i)] = 0.5f;
+
+            const auto markers = LoopTrimmer::findAudibleRegion(channels, 2, numSamples, sampleRate);
+            expectEquals(markers.start, 0);
+            expectEquals(markers.length, numSamples);
+        }
+
+        beginTest("A take loud throughout is kept whole, in either precision");
+        {
+            std::vector<double> loud(numSamples, 0.25);
+            const double* loudChannels[] = { loud.data() };
+
+            const auto markers = LoopTrimmer::findAudibleRegion(loudChannels, 1, numSamples, sampleRate);
+            expectEquals(markers.start, 0);
+            expectEquals(markers.length, numSamples);
+
+            // A take shorter than a window
+            const auto shortMarkers = LoopTrimmer::findAudibleRegion(loudChannels, 1, 10, sampleRate);
+            expectEquals(shortMarkers.start, 0);
+            expectEquals(shortMarkers.length, 10);
+        }
+
+        beginTest("Markers survive packing, and no proposal packs to 0");
+        {
+            for (const auto& markers : { LoopTrimmer::Markers { 0, 1 }, LoopTrimmer::Markers { 1, 0 },
+                                         LoopTrimmer::Markers { 12345, 678901 }, LoopTrimmer::Markers { 0x7fffffff, 0x7fffffff } })
+            {
+                const auto packed = markers.pack();
+                expect(packed != 0);
+
+                const auto unpacked = LoopTrimmer::Markers::unpack(packed);
+                expectEquals(unpacked.start, markers.start);
+                expectEquals(unpacked.length, markers.length);
+            }
+
+            expectEquals(LoopTrimmer::Markers {}.pack(), static_cast<std::uint64_t>(0));
+            expectEquals(LoopTrimmer::Markers::unpack(0).length, 0);
+        }
+    }
+};
+
+static LoopTrimmerTests loopTrimmerTests;
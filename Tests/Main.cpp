@@ -0,0 +1,19 @@
+#include <juce_core/juce_core.h>
+
+//==============================================================================
+/*
+    Runs every juce::UnitTest linked into the program and exits nonzero if any
+    expectation failed, so ctest reports it. Built with -DBOOMERANG_BUILD_TESTS=ON.
+*/
+int main()
+{
+    juce::UnitTestRunner runner;
+    runner.runAllTests();
+
+    int numFailures = 0;
+
+    for (int i = 0; i < runner.getNumResults(); ++i)
+        numFailures += runner.getResult(i)->failures;
+
+    return numFailures > 0 ? 1 : 0;
+}
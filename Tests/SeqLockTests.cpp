@@ -0,0 +1,93 @@
+#include "SeqLock.h"
+#include <thread>
+
+//==============================================================================
+namespace
+{
+    // Every field derived from one counter, so a torn read shows up as a mismatch
+    struct Published
+    {
+        std::uint32_t counter = 0;
+        double square = 0.0;
+        std::uint8_t low = 0;
+        float half = 0.0f;
+
+        static Published from(std::uint32_t counter)
+        {
+            return { counter, static_cast<double>(counter) * counter, static_cast<std::uint8_t>(counter & 0xff), static_cast<float>(counter) * 0.5f };
+        }
+
+        bool isCoherent() const { return square == static_cast<double>(counter) * counter && low == (counter & 0xff) && half == static_cast<float>(counter) * 0.5f; }
+    };
+}
+
+//==============================================================================
+class SeqLockTests : public juce::UnitTest
+{
+public:
+    SeqLockTests() : juce::UnitTest("SeqLock", "Boomerang") {}
+
+    void runTest() override
+    {
+        beginTest("A new lock holds a default value");
+        {
+            SeqLock<Published> lock;
+            expectEquals(lock.load().counter, static_cast<std::uint32_t>(0));
+            expect(lock.load().isCoherent());
+        }
+
+        beginTest("A load returns the last store");
+        {
+            SeqLock<Published> lock;
+
+            for (std::uint32_t counter : { 1u, 7u, 100000u, 3u })
+            {
+                lock.store(Published::from(counter));
+                const auto loaded = lock.load();
+                expectEquals(loaded.counter, counter);
+                expect(loaded.isCoherent());
+            }
+        }
+
+        beginTest("Readers racing the writer only see whole values, in order");
+        {
+            SeqLock<Published> lock;
+            constexpr std::uint32_t numStores = 200000;
+            std::atomic<bool> done { false };
+            std::atomic<int> numTorn { 0 }, numBackwards { 0 };
+
+            auto read = [&]
+            {
+                std::uint32_t last = 0;
+
+                while (!done.load())
+                {
+                    const auto loaded = lock.load();
+
+                    if (!loaded.isCoherent())
+                        ++numTorn;
+
+                    if (loaded.counter < last)
+                        ++numBackwards;
+
+                    last = loaded.counter;
+                }
+            };
+
+            std::thread firstReader(read), secondReader(read);
+
+            for (std::uint32_t counter = 1; counter <= numStores; ++counter)
+                lock.store(Published::from(counter));
+
+            done = true;
+            firstReader.join();
+            secondReader.join();
+
+            expectEquals(numTorn.load(), 0);
+            expectEquals(numBackwards.load(), 0);
+            expectEquals(lock.load().counter, numStores);
+        }
+    }
+};
+
+static SeqLockTests seqLockTests;
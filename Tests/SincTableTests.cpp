@@ -0,0 +1,112 @@
+#include "SincTable.h"
+#include <cmath>
+
+//==============================================================================
+namespace
+{
+    // Reads a cosine of freq (cycles per sample) at integer position plus fraction through
+    // one kernel, and returns the worst error against the cosine's true value there
+    double getReadError(const float* band, double freq, double gain, float fraction)
+    {
+        constexpr int position = 100;
+        float weights[SincTable::numTaps];
+        SincTable::computeWeights(band, fraction, weights);
+
+        double worst = 0.0;
+
+        for (double phase : { 0.0, 0.7, 1.9, 3.1 })
+        {
+            double read = 0.0;
+            for (int tap = 0; tap < SincTable::numTaps; ++tap)
+                read += weights[tap] * std::cos(juce::MathConstants<double>::twoPi * freq * (position - SincTable::tapsBeforePosition + tap) + phase);
+
+            const double expected = gain * std::cos(juce::MathConstants<double>::twoPi * freq * (position + fraction) + phase);
+            worst = juce::jmax(worst, std::abs(read - expected));
+        }
+
+        return worst;
+    }
+
+    // Gain at freq: the amplitude of the kernel's response to a complex exponential
+    double getGain(const float* band, double freq, float fraction)
+    {
+        float weights[SincTable::numTaps];
+        SincTable::computeWeights(band, fraction, weights);
+
+        double real = 0.0, imaginary = 0.0;
+
+        for (int tap = 0; tap < SincTable::numTaps; ++tap)
+        {
+            const double angle = juce::MathConstants<double>::twoPi * freq * (tap - SincTable::tapsBeforePosition - fraction);
+            real += weights[tap] * std::cos(angle);
+            imaginary += weights[tap] * std::sin(angle);
+        }
+
+        return std::hypot(real, imaginary);
+    }
+}
+
+//==============================================================================
+class SincTableTests : public juce::UnitTest
+{
+public:
+    SincTableTests() : juce::UnitTest("SincTable", "Boomerang") {}
+
+    void runTest() override
+    {
+        SincTable table;
+
+        beginTest("Every kernel passes DC at unity gain");
+        {
+            for (double rate : { 0.5, 1.0, 1.5, 2.0, 3.0, 4.0, 6.0, 8.0 })
+            {
+                for (int step = 0; step < 64; ++step)
+                {
+                    float weights[SincTable::numTaps];
+                    SincTable::computeWeights(table.getBand(rate), step / 64.0f, weights);
+
+                    double sum = 0.0;
+                    for (const float weight : weights)
+                        sum += weight;
+
+                    expectWithinAbsoluteError(sum, 1.0, 1.0e-4);
+                }
+            }
+        }
+
+        beginTest("At 1x, tones below 0.22 cycles per sample are read back between samples");
+        {
+            for (double freq : { 0.01, 0.05, 0.1, 0.15, 0.2, 0.22 })
+                for (float fraction : { 0.0f, 0.25f, 0.5f, 0.75f, 0.99f })
+                    expectLessThan(getReadError(table.getBand(1.0), freq, 1.0, fraction), 2.0e-3);
+        }
+
+        beginTest("Faster rates pass their own band");
+        {
+            expectGreaterThan(getGain(table.getBand(2.0), 0.05, 0.5f), 0.99);
+            expectGreaterThan(getGain(table.getBand(4.0), 0.05, 0.5f), 0.85);
+        }
+
+        beginTest("Faster rates reject what would alias once read through");
+        {
+            for (float fraction : { 0.0f, 0.3f, 0.5f })
+            {
+                for (double freq : { 0.4, 0.45, 0.5 })
+                    expectLessThan(getGain(table.getBand(2.0), freq, fraction), 0.01);
+
+                for (double freq : { 0.3, 0.4, 0.5 })
+                    expectLessThan(getGain(table.getBand(4.0), freq, fraction), 0.01);
+            }
+        }
+
+        beginTest("Rates between bands use the next band up");
+        {
+            expect(table.getBand(1.0) != table.getBand(1.2));
+            expect(table.getBand(1.2) == table.getBand(1.5));
+            expect(table.getBand(8.0) == table.getBand(16.0));
+            expect(table.getBand(0.25) == table.getBand(1.0));
+        }
+    }
+};
+
+static SincTableTests sincTableTests;
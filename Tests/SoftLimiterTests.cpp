@@ -0,0 +1,64 @@
+#include "SoftLimiter.h"
+#include <vector>
+
+//==============================================================================
+class SoftLimiterTests : public juce::UnitTest
+{
+public:
+    SoftLimiterTests() : juce::UnitTest("SoftLimiter", "Boomerang") {}
+
+    void runTest() override
+    {
+        beginTest("Samples below the knee pass untouched");
+        {
+            std::vector<float> samples;
+            for (int i = -100; i <= 100; ++i)
+                samples.push_back(SoftLimiter::kneeLevel * static_cast<float>(i) / 100.0f);
+
+            auto limited = samples;
+            SoftLimiter::process(limited.data(), static_cast<int>(limited.size()));
+
+            for (size_t i = 0; i < samples.size(); ++i)
+                expectEquals(limited[i], samples[i]);
+        }
+
+        beginTest("Above the knee, the curve rises smoothly to the ceiling and stays there");
+        {
+            std::vector<double> samples;
+            for (int i = 0; i <= 4000; ++i)
+                samples.push_back(SoftLimiter::kneeLevel + static_cast<double>(i) / 1000.0);
+
+            auto limited = samples;
+            SoftLimiter::process(limited.data(), static_cast<int>(limited.size()));
+
+            for (size_t i = 1; i < limited.size(); ++i)
+            {
+                expectLessOrEqual(limited[i], static_cast<double>(SoftLimiter::ceilingLevel));
+                expectGreaterOrEqual(limited[i], limited[i - 1]);
+
+                // Never steeper than the linear part, so the knee has no kink upwards
+                expectLessOrEqual(limited[i] - limited[i - 1], samples[i] - samples[i - 1] + 1.0e-9);
+            }
+
+            expectWithinAbsoluteError(limited.back(), static_cast<double>(SoftLimiter::ceilingLevel), 1.0e-9);
+        }
+
+        beginTest("Negative samples limit like positive ones");
+        {
+            std::vector<float> positive, negative;
+            for (int i = 0; i <= 300; ++i)
+            {
+                positive.push_back(static_cast<float>(i) / 100.0f);
+                negative.push_back(-positive.back());
+            }
+
+            SoftLimiter::process(positive.data(), static_cast<int>(positive.size()));
+            SoftLimiter::process(negative.data(), static_cast<int>(negative.size()));
+
+            for (size_t i = 0; i < positive.size(); ++i)
+                expectEquals(negative[i], -positive[i]);
+        }
+    }
+};
+
+static SoftLimiterTests softLimiterTests;